@@ -0,0 +1,392 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BinaryTapeDev.hpp"
+#include "TapeDevExceptions.hpp"
+
+namespace {
+
+/// Смещение ячейки с переданным индексом относительно начала файла ленты.
+template <typename T>
+off_t cellOffset(size_t t_index) noexcept {
+  return static_cast<off_t>(BasicBinaryTapeDev<T>::kHeaderSize +
+                            t_index * BasicBinaryTapeDev<T>::kCellSize);
+}
+
+}  // namespace
+
+template <typename T>
+BasicBinaryTapeDev<T>::BasicBinaryTapeDev(const std::filesystem::path& t_tape_file_path,
+                                          const TapeDevConfig& t_dev_config,
+                                          const TapeDevOperationMode t_mode)
+    : m_tape_file_path(t_tape_file_path),
+      m_dev_config(t_dev_config),
+      m_operation_mode(t_mode),
+      m_fd(-1),
+      m_cell_count(0),
+      m_header_dirty_flag(false),
+      m_head_pos(0) {
+  open();
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::open() {
+  int flags = 0;
+  if (m_operation_mode == TapeDevOperationMode::Read) {
+    flags = O_RDONLY;
+  } else if (m_operation_mode == TapeDevOperationMode::Write) {
+    flags = O_RDWR | O_CREAT | O_TRUNC;
+  } else {  // TapeDevOperationMode::ReadWrite и TapeDevOperationMode::Append
+    flags = O_RDWR;
+  }
+
+  m_fd = ::open(m_tape_file_path.c_str(), flags, 0644);
+  if (m_fd < 0) {
+    throw BadTapeException("Не удалось отктыть файл ленты '" + m_tape_file_path.string() +
+                           "': " + std::strerror(errno) + ".");
+  }
+
+  m_cell_count = 0;
+  m_head_pos = 0;
+  m_header_dirty_flag = false;
+
+  if (m_operation_mode == TapeDevOperationMode::Write) {
+    // Новая лента: сразу записываем заголовок с нулевым количеством ячеек.
+    if (!writeHeader()) {
+      ::close(m_fd);
+      m_fd = -1;
+      throw BadTapeException("Не удалось записать заголовок файла ленты '" +
+                             m_tape_file_path.string() + "'.");
+    }
+    return;
+  }
+
+  unsigned char header[kHeaderSize];
+  if (::pread(m_fd, header, kHeaderSize, 0) != static_cast<ssize_t>(kHeaderSize) ||
+      std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+    ::close(m_fd);
+    m_fd = -1;
+    throw BadTapeException("Файл '" + m_tape_file_path.string() +
+                           "' не является файлом ленты в бинарном формате.");
+  }
+
+  std::uint64_t cell_count = 0;
+  for (size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+    cell_count |= static_cast<std::uint64_t>(header[sizeof(kMagic) + i]) << (8 * i);
+  }
+
+  const off_t file_size = ::lseek(m_fd, 0, SEEK_END);
+
+  if (m_operation_mode == TapeDevOperationMode::Append) {
+    // Заголовок мог не успеть обновиться после записи ячеек (например, при
+    // аварийном завершении программы) или, наоборот, опередить обрезанный
+    // файл, поэтому при дозаписи количество ячеек определяется по размеру
+    // файла. Неполная последняя ячейка отбрасывается и будет перезаписана.
+    m_cell_count = (static_cast<size_t>(file_size) - kHeaderSize) / kCellSize;
+    m_header_dirty_flag = m_cell_count != cell_count;
+    m_head_pos = m_cell_count;
+    return;
+  }
+
+  // Проверяем, что файл действительно содержит заявленное в заголовке
+  // количество ячеек.
+  if (file_size < cellOffset<T>(cell_count)) {
+    ::close(m_fd);
+    m_fd = -1;
+    throw BadTapeException("Файл ленты '" + m_tape_file_path.string() +
+                           "' содержит меньше ячеек, чем указано в заголовке.");
+  }
+
+  m_cell_count = cell_count;
+}
+
+template <typename T>
+bool BasicBinaryTapeDev<T>::writeHeader() noexcept {
+  unsigned char header[kHeaderSize];
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  const auto cell_count = static_cast<std::uint64_t>(m_cell_count);
+  for (size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+    header[sizeof(kMagic) + i] = static_cast<unsigned char>(cell_count >> (8 * i));
+  }
+
+  m_header_dirty_flag = false;
+
+  return ::pwrite(m_fd, header, kHeaderSize, 0) == static_cast<ssize_t>(kHeaderSize);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::close() noexcept {
+  if (m_fd < 0) {
+    return;
+  }
+
+  if (m_header_dirty_flag) {
+    // Деструктор не может сообщить об ошибке, поэтому результат не
+    // проверяется: при неудаче заголовок останется с прежним количеством
+    // ячеек, и лента будет прочитана как более короткая.
+    writeHeader();
+  }
+
+  ::close(m_fd);
+  m_fd = -1;
+}
+
+template <typename T>
+T BasicBinaryTapeDev<T>::read() {
+  if (m_operation_mode != TapeDevOperationMode::Read &&
+      m_operation_mode != TapeDevOperationMode::ReadWrite) {
+    throw InvalidOperationException(
+        "Чтение невозможно. Устройство работает в режиме только запись.");
+  }
+
+  if (m_head_pos >= m_cell_count) {
+    throw EndOfTapeException();
+  }
+
+  unsigned char bytes[kCellSize];
+  if (::pread(m_fd, bytes, kCellSize, cellOffset<T>(m_head_pos)) !=
+      static_cast<ssize_t>(kCellSize)) {
+    throw BadTapeException("Не удалось считать ячейку " + std::to_string(m_head_pos) +
+                           " с ленты '" + m_tape_file_path.string() + "'.");
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения чтения с ленты.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.read_delay);
+
+  return TapeCellCodec<T>::decode(bytes);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::write(T t_value) {
+  if (m_operation_mode == TapeDevOperationMode::Read) {
+    throw InvalidOperationException(
+        "Запись невозможна. Устройство работает в режиме только чтение.");
+  }
+
+  unsigned char bytes[kCellSize];
+  TapeCellCodec<T>::encode(t_value, bytes);
+
+  // В режимах Write и Append значение всегда дописывается в конец ленты.
+  const size_t cell_index =
+      m_operation_mode == TapeDevOperationMode::ReadWrite ? m_head_pos : m_cell_count;
+
+  if (::pwrite(m_fd, bytes, kCellSize, cellOffset<T>(cell_index)) !=
+      static_cast<ssize_t>(kCellSize)) {
+    throw BadTapeException("Не удалось записать ячейку " + std::to_string(cell_index) +
+                           " на ленту '" + m_tape_file_path.string() + "'.");
+  }
+
+  if (cell_index == m_cell_count) {
+    m_cell_count += 1;
+    m_header_dirty_flag = true;
+  }
+
+  if (m_operation_mode != TapeDevOperationMode::ReadWrite) {
+    m_head_pos = m_cell_count;
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения записи на ленту.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.write_delay);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::flush() {
+  if (m_header_dirty_flag && !writeHeader()) {
+    throw BadTapeException("Не удалось записать заголовок файла ленты '" +
+                           m_tape_file_path.string() + "'.");
+  }
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::shiftLeft() {
+  if (m_operation_mode == TapeDevOperationMode::Write ||
+      m_operation_mode == TapeDevOperationMode::Append) {
+    throw InvalidOperationException(
+        "В режимах работы устройства TapeDevOperationMode::Write и "
+        "TapeDevOperationMode::Append сдвиг влево не поддерживается.");
+  }
+
+  if (m_head_pos == 0) {
+    return;
+  }
+
+  m_head_pos -= 1;
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию влево.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::shiftRight() {
+  if (m_operation_mode == TapeDevOperationMode::Write ||
+      m_operation_mode == TapeDevOperationMode::Append) {
+    throw InvalidOperationException(
+        "В режимах работы устройства TapeDevOperationMode::Write и "
+        "TapeDevOperationMode::Append сдвиг вправо не поддерживается.");
+  }
+
+  if (m_head_pos >= m_cell_count) {
+    return;
+  }
+
+  m_head_pos += 1;
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию вправо.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::rewind() {
+  if (m_operation_mode == TapeDevOperationMode::Write ||
+      m_operation_mode == TapeDevOperationMode::Append) {
+    throw InvalidOperationException(
+        "В режимах работы устройства TapeDevOperationMode::Write и "
+        "TapeDevOperationMode::Append перемотка ленты в начало не поддерживается.");
+  }
+
+  m_head_pos = 0;
+
+  // Эмулируем время, необходимое устройству для выполнения перемотки ленты в
+  // начало.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.rewind_delay);
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::seekToCell(size_t t_cell) {
+  if (m_operation_mode == TapeDevOperationMode::Write ||
+      m_operation_mode == TapeDevOperationMode::Append) {
+    throw InvalidOperationException(
+        "В режимах работы устройства TapeDevOperationMode::Write и "
+        "TapeDevOperationMode::Append перемещение головки не поддерживается.");
+  }
+
+  const size_t head_pos = m_head_pos;
+  m_head_pos = std::min(t_cell, m_cell_count);
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на каждую
+  // ячейку пройденного расстояния.
+  const size_t distance = m_head_pos > head_pos ? m_head_pos - head_pos : head_pos - m_head_pos;
+  emulateTapeDevDelay(m_dev_config,
+                      m_dev_config.shift_delay * static_cast<long long>(distance));
+}
+
+template <typename T>
+size_t BasicBinaryTapeDev<T>::readBlock(T* t_buf, size_t t_count) {
+  if (m_operation_mode != TapeDevOperationMode::Read &&
+      m_operation_mode != TapeDevOperationMode::ReadWrite) {
+    throw InvalidOperationException(
+        "Чтение невозможно. Устройство работает в режиме только запись.");
+  }
+
+  const size_t num_cells = std::min(t_count, m_cell_count - std::min(m_head_pos, m_cell_count));
+  if (num_cells == 0) {
+    return 0;
+  }
+
+  // Читаем байты ячеек прямо в буфер назначения и декодируем их на месте.
+  auto* bytes = reinterpret_cast<unsigned char*>(t_buf);
+  const auto num_bytes = static_cast<ssize_t>(num_cells * kCellSize);
+  if (::pread(m_fd, bytes, num_bytes, cellOffset<T>(m_head_pos)) != num_bytes) {
+    throw BadTapeException("Не удалось считать ячейки с ленты '" + m_tape_file_path.string() +
+                           "'.");
+  }
+  for (size_t i = 0; i < num_cells; ++i) {
+    t_buf[i] = TapeCellCodec<T>::decode(bytes + i * kCellSize);
+  }
+
+  m_head_pos += num_cells;
+
+  // Эмулируем время, необходимое устройству для выполнения чтения и сдвига
+  // для каждой ячейки блока.
+  emulateTapeDevDelay(m_dev_config,
+                      (m_dev_config.read_delay + m_dev_config.shift_delay) * num_cells);
+
+  return num_cells;
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::writeBlock(const T* t_buf, size_t t_count) {
+  if (m_operation_mode == TapeDevOperationMode::Read) {
+    throw InvalidOperationException(
+        "Запись невозможна. Устройство работает в режиме только чтение.");
+  }
+
+  if (t_count == 0) {
+    return;
+  }
+
+  std::vector<unsigned char> bytes(t_count * kCellSize);
+  for (size_t i = 0; i < t_count; ++i) {
+    TapeCellCodec<T>::encode(t_buf[i], bytes.data() + i * kCellSize);
+  }
+
+  // В режимах Write и Append блок всегда дописывается в конец ленты.
+  const size_t cell_index =
+      m_operation_mode == TapeDevOperationMode::ReadWrite ? m_head_pos : m_cell_count;
+
+  const auto num_bytes = static_cast<ssize_t>(bytes.size());
+  if (::pwrite(m_fd, bytes.data(), bytes.size(), cellOffset<T>(cell_index)) != num_bytes) {
+    throw BadTapeException("Не удалось записать ячейки на ленту '" + m_tape_file_path.string() +
+                           "'.");
+  }
+
+  if (cell_index + t_count > m_cell_count) {
+    m_cell_count = cell_index + t_count;
+    m_header_dirty_flag = true;
+  }
+
+  m_head_pos = m_operation_mode == TapeDevOperationMode::ReadWrite ? cell_index + t_count
+                                                                     : m_cell_count;
+
+  // Эмулируем время, необходимое устройству для выполнения записи каждой
+  // ячейки блока.
+  emulateTapeDevDelay(m_dev_config,
+                      m_dev_config.write_delay * static_cast<long long>(t_count));
+}
+
+template <typename T>
+size_t BasicBinaryTapeDev<T>::getHeadPos() const noexcept {
+  return m_head_pos;
+}
+
+template <typename T>
+bool BasicBinaryTapeDev<T>::atStartOfTape() const noexcept {
+  return m_head_pos == 0;
+}
+
+template <typename T>
+bool BasicBinaryTapeDev<T>::atEndOfTape() const noexcept {
+  return m_head_pos >= m_cell_count;
+}
+
+template <typename T>
+size_t BasicBinaryTapeDev<T>::getCellCount() const noexcept {
+  return m_cell_count;
+}
+
+template <typename T>
+void BasicBinaryTapeDev<T>::replaceTape(const std::filesystem::path& t_new_tape_file_path,
+                                           TapeDevOperationMode t_mode) {
+  close();
+  m_tape_file_path = t_new_tape_file_path;
+  m_operation_mode = t_mode;
+  open();
+}
+
+template <typename T>
+BasicBinaryTapeDev<T>::~BasicBinaryTapeDev() noexcept {
+  close();
+}
+
+template class BasicBinaryTapeDev<std::int32_t>;
+template class BasicBinaryTapeDev<std::int64_t>;
+template class BasicBinaryTapeDev<std::uint64_t>;
+template class BasicBinaryTapeDev<TapeRecord>;
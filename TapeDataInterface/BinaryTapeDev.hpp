@@ -0,0 +1,136 @@
+#ifndef BINARY_TAPE_DEV_HPP
+#define BINARY_TAPE_DEV_HPP
+
+#include <cstdint>
+#include <filesystem>
+
+#include "ITapeDev.hpp"
+#include "TapeCellCodec.hpp"
+#include "TapeDevConfig.hpp"
+
+/*
+ * Класс BasicBinaryTapeDev
+ *
+ * Ленточное устройство, эмулирующее работу с лентой посредством файла в
+ * бинарном формате (см. doc/tape_file_format.md). Ячейки ленты имеют
+ * фиксированную ширину, поэтому сдвиг головки сводится к изменению её позиции,
+ * а чтение и запись ячейки выполняются одним вызовом pread()/pwrite(). Запись
+ * в режиме TapeDevOperationMode::ReadWrite изменяет ячейку на месте и не
+ * требует перезаписи файла ленты.
+ *
+ * Ячейки кодируются кодеком TapeCellCodec<T>, а сигнатура файла ленты
+ * определяется типом ячейки, поэтому ленту нельзя прочитать устройством для
+ * ячеек другого типа. Устройство для ячеек типа 'int' доступно под именем
+ * BinaryTapeDev.
+ */
+template <typename T>
+class BasicBinaryTapeDev final : public IBasicTapeDev<T> {
+ public:
+  /// Открывает файл ленты в переданном режиме работы.
+  ///
+  /// Если файл ленты не удалось открыть или он не является валидным файлом
+  /// ленты в бинарном формате, выбрасывает BadTapeException.
+  BasicBinaryTapeDev(const std::filesystem::path&, const TapeDevConfig&,
+                     const TapeDevOperationMode);
+
+  BasicBinaryTapeDev(const BasicBinaryTapeDev&) = delete;
+
+  BasicBinaryTapeDev& operator=(const BasicBinaryTapeDev&) = delete;
+
+  /// Считывает значение из ячейки на текущей позиции головки. При попытке
+  /// чтения за концом ленты выбрасывает EndOfTapeException.
+  T read() override;
+
+  /// В режимах TapeDevOperationMode::Write и TapeDevOperationMode::Append
+  /// дописывает значение в конец ленты. В режиме
+  /// TapeDevOperationMode::ReadWrite перезаписывает ячейку на текущей позиции
+  /// головки (или дописывает значение, если головка находится в конце ленты).
+  void write(T) override;
+
+  void shiftLeft() override;
+
+  void shiftRight() override;
+
+  void rewind() override;
+
+  /// Ячейки имеют фиксированную ширину, поэтому головка перемещается к
+  /// ячейке сразу.
+  void seekToCell(size_t) override;
+
+  /// Считывает блок ячеек одним вызовом pread().
+  size_t readBlock(T*, size_t) override;
+
+  /// Записывает блок ячеек одним вызовом pwrite().
+  void writeBlock(const T*, size_t) override;
+
+  /// Ячейки записываются в файл ленты сразу, поэтому записывает в заголовок
+  /// только актуальное количество ячеек, если оно изменилось. При ошибке
+  /// записи выбрасывает BadTapeException.
+  void flush() override;
+
+  size_t getHeadPos() const noexcept override;
+
+  bool atStartOfTape() const noexcept override;
+
+  bool atEndOfTape() const noexcept override;
+
+  /// Возвращает количество ячеек на ленте.
+  size_t getCellCount() const noexcept;
+
+  /// Закрывает текущий файл ленты и открывает файл ленты, расположенный по
+  /// переданному пути, в переданном режиме работы.
+  void replaceTape(const std::filesystem::path&, TapeDevOperationMode);
+
+  ~BasicBinaryTapeDev() noexcept;
+
+  /// Сигнатура в начале бинарного файла ленты.
+  static constexpr const char (&kMagic)[8] = TapeCellCodec<T>::kBinaryMagic;
+
+  /// Размер заголовка бинарного файла ленты: сигнатура и количество ячеек.
+  static constexpr size_t kHeaderSize = sizeof(kMagic) + sizeof(std::uint64_t);
+
+  /// Размер ячейки ленты в байтах.
+  static constexpr size_t kCellSize = TapeCellCodec<T>::kBinarySize;
+
+  // Блок ячеек считывается прямо в буфер значений и декодируется на месте.
+  static_assert(kCellSize == sizeof(T), "Размер ячейки должен совпадать с размером значения.");
+
+ private:
+  /// Открывает файл ленты m_tape_file_path в режиме m_operation_mode и
+  /// читает (или создаёт) заголовок.
+  void open();
+
+  /// Записывает заголовок файла ленты с актуальным количеством ячеек.
+  /// Возвращает false, если запись не удалась.
+  bool writeHeader() noexcept;
+
+  /// Записывает в заголовок файла ленты актуальное количество ячеек и
+  /// закрывает файл.
+  void close() noexcept;
+
+  /// Путь к файлу ленты.
+  std::filesystem::path m_tape_file_path;
+
+  /// Объект, который хранит конфигурацию устройства.
+  const TapeDevConfig m_dev_config;
+
+  /// Режим работы ленточного устройства.
+  TapeDevOperationMode m_operation_mode;
+
+  /// Файловый дескриптор файла ленты.
+  int m_fd;
+
+  /// Количество ячеек на ленте.
+  size_t m_cell_count;
+
+  /// Показывает, что количество ячеек на ленте изменилось и заголовок файла
+  /// нужно обновить.
+  bool m_header_dirty_flag;
+
+  /// Текущая позиция считывающей/записыващей магнитной головки на ленте.
+  size_t m_head_pos;
+};
+
+using BinaryTapeDev = BasicBinaryTapeDev<int>;
+
+#endif  // BINARY_TAPE_DEV_HPP
@@ -1,20 +1,39 @@
 #ifndef I_TAPE_DEV_H
 #define I_TAPE_DEV_H
 
+#include <cstddef>
+
+#include "TapeCellCodec.hpp"
+
+// FIXME: добавить документирующие комментарии.
+/// Перечисление, определяющее возможные режимы работы ленточного устройства.
+enum class TapeDevOperationMode { Read, Write, ReadWrite, Append };
+
+/// Перечисление, определяющее возможные форматы файла ленты
+/// (см. doc/tape_file_format.md).
+enum class TapeFileFormat { Text, Binary };
+
 /*
- * Интерфейсный класс (интерфейс) ITapeDev
+ * Интерфейсный класс (интерфейс) IBasicTapeDev
  *
  * От данного класса будут наследоваться любые другие классы, в которых мы хотим
  * реализовать функциональность устройства хранения данных типа лента.
+ *
+ * Параметр шаблона T - тип значения ячейки ленты (см. TapeCellCodec).
+ * Устройства для ячеек типа 'int' доступны под именем ITapeDev.
  */
-class ITapeDev {
+template <typename T>
+class IBasicTapeDev {
  public:
-  /// Читает число из ячейки на текущей позиции считывающей головки.
-  virtual int read() = 0;
+  /// Тип значения ячейки ленты.
+  using value_type = T;
+
+  /// Читает значение из ячейки на текущей позиции считывающей головки.
+  virtual T read() = 0;
 
-  /// Записывает число, переданное в качестве аргумента, на текущую позицию
+  /// Записывает значение, переданное в качестве аргумента, на текущую позицию
   /// считывающей головки.
-  virtual void write(int) = 0;
+  virtual void write(T) = 0;
 
   /// Выполняет сдвиг считывающей/записывающей головки на одну ячейку влево
   /// от текущей позиции.
@@ -27,7 +46,44 @@ class ITapeDev {
   /// Выполняет перемотку ленты в начало.
   virtual void rewind() = 0;
 
-  virtual ~ITapeDev() = default;
+  /// Перемещает считывающую/записывающую головку к ячейке с переданным
+  /// индексом (или к концу ленты, если ячеек меньше). Эквивалентно
+  /// последовательности вызовов shiftLeft() или shiftRight(): эмулируется
+  /// задержка сдвига на каждую ячейку пройденного расстояния, но устройство
+  /// может переместить головку без последовательного прохода по ленте.
+  virtual void seekToCell(size_t) = 0;
+
+  /// Считывает до t_count значений, начиная с ячейки на текущей позиции
+  /// головки, в переданный буфер и сдвигает головку вправо на количество
+  /// считанных значений. Эквивалентно последовательности пар вызовов read() и
+  /// shiftRight(), но выполняется за один проход по ленте.
+  ///
+  /// Возвращает количество считанных значений: меньше t_count, если был
+  /// достигнут конец ленты.
+  virtual size_t readBlock(T* t_buf, size_t t_count) = 0;
+
+  /// Записывает t_count значений из переданного буфера, начиная с текущей
+  /// позиции головки, и сдвигает головку на количество записанных значений.
+  /// Эквивалентно последовательности вызовов write() (и shiftRight() в режиме
+  /// TapeDevOperationMode::ReadWrite), но выполняется за один проход по ленте.
+  virtual void writeBlock(const T* t_buf, size_t t_count) = 0;
+
+  /// Записывает в файл ленты значения, накопленные в буфере записи
+  /// устройства. Устройства без буфера записи ничего не делают.
+  virtual void flush() = 0;
+
+  /// Возвращает текущую позицию считывающей/записывающей головки на ленте.
+  virtual size_t getHeadPos() const noexcept = 0;
+
+  /// Показывает, находится ли считывающая/записывающая головка в начале ленты.
+  virtual bool atStartOfTape() const noexcept = 0;
+
+  /// Показывает, находится ли считывающая/записывающая головка в конце ленты.
+  virtual bool atEndOfTape() const noexcept = 0;
+
+  virtual ~IBasicTapeDev() = default;
 };
 
+using ITapeDev = IBasicTapeDev<int>;
+
 #endif  // I_TAPE_DEV_H
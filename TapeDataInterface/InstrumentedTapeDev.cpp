@@ -0,0 +1,132 @@
+#include "InstrumentedTapeDev.hpp"
+
+template <typename T>
+BasicInstrumentedTapeDev<T>::BasicInstrumentedTapeDev(
+    std::unique_ptr<IBasicTapeDev<T>> t_tape_dev, const std::filesystem::path& t_tape_file_path,
+    const TapeDevConfig& t_dev_config, TapeDevOperationMode t_mode, TapeDevStats& t_stats) noexcept
+    : m_tape_dev(std::move(t_tape_dev)),
+      m_tape_file_path(t_tape_file_path),
+      m_dev_config(t_dev_config),
+      m_operation_mode(t_mode),
+      m_stats(t_stats) {}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::record(TapeDevOperation t_operation, uint64_t t_cells,
+                                      uint64_t t_emulated_time_ms, Clock::time_point t_start) {
+  const auto real_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t_start);
+  m_stats.record(m_tape_file_path, t_operation, t_cells, t_emulated_time_ms, real_time.count());
+}
+
+template <typename T>
+T BasicInstrumentedTapeDev<T>::read() {
+  const Clock::time_point start = Clock::now();
+  const T value = m_tape_dev->read();
+  record(TapeDevOperation::Read, 1, m_dev_config.read_delay, start);
+  return value;
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::write(T t_value) {
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->write(t_value);
+  record(TapeDevOperation::Write, 1, m_dev_config.write_delay, start);
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::shiftLeft() {
+  const size_t head_pos = m_tape_dev->getHeadPos();
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->shiftLeft();
+  // Сдвиг в начале ленты не перемещает головку и не учитывается.
+  if (m_tape_dev->getHeadPos() != head_pos) {
+    record(TapeDevOperation::ShiftLeft, 1, m_dev_config.shift_delay, start);
+  }
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::shiftRight() {
+  const size_t head_pos = m_tape_dev->getHeadPos();
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->shiftRight();
+  // Сдвиг в конце ленты не перемещает головку и не учитывается.
+  if (m_tape_dev->getHeadPos() != head_pos) {
+    record(TapeDevOperation::ShiftRight, 1, m_dev_config.shift_delay, start);
+  }
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::rewind() {
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->rewind();
+  record(TapeDevOperation::Rewind, 1, m_dev_config.rewind_delay, start);
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::seekToCell(size_t t_cell) {
+  const size_t head_pos = m_tape_dev->getHeadPos();
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->seekToCell(t_cell);
+  const size_t new_head_pos = m_tape_dev->getHeadPos();
+  if (new_head_pos > head_pos) {
+    record(TapeDevOperation::ShiftRight, new_head_pos - head_pos,
+           m_dev_config.shift_delay * (new_head_pos - head_pos), start);
+  } else if (new_head_pos < head_pos) {
+    record(TapeDevOperation::ShiftLeft, head_pos - new_head_pos,
+           m_dev_config.shift_delay * (head_pos - new_head_pos), start);
+  }
+}
+
+template <typename T>
+size_t BasicInstrumentedTapeDev<T>::readBlock(T* t_buf, size_t t_count) {
+  const Clock::time_point start = Clock::now();
+  const size_t num_read_values = m_tape_dev->readBlock(t_buf, t_count);
+  if (num_read_values > 0) {
+    record(TapeDevOperation::Read, num_read_values, m_dev_config.read_delay * num_read_values,
+           start);
+    m_stats.record(m_tape_file_path, TapeDevOperation::ShiftRight, num_read_values,
+                   m_dev_config.shift_delay * num_read_values, 0);
+  }
+  return num_read_values;
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::writeBlock(const T* t_buf, size_t t_count) {
+  const Clock::time_point start = Clock::now();
+  m_tape_dev->writeBlock(t_buf, t_count);
+  if (t_count == 0) {
+    return;
+  }
+  record(TapeDevOperation::Write, t_count, m_dev_config.write_delay * t_count, start);
+  // В режиме TapeDevOperationMode::ReadWrite головка сдвигается после каждой
+  // записи, в остальных режимах запись дописывает ленту.
+  if (m_operation_mode == TapeDevOperationMode::ReadWrite) {
+    m_stats.record(m_tape_file_path, TapeDevOperation::ShiftRight, t_count,
+                   m_dev_config.shift_delay * t_count, 0);
+  }
+}
+
+template <typename T>
+void BasicInstrumentedTapeDev<T>::flush() {
+  m_tape_dev->flush();
+}
+
+template <typename T>
+size_t BasicInstrumentedTapeDev<T>::getHeadPos() const noexcept {
+  return m_tape_dev->getHeadPos();
+}
+
+template <typename T>
+bool BasicInstrumentedTapeDev<T>::atStartOfTape() const noexcept {
+  return m_tape_dev->atStartOfTape();
+}
+
+template <typename T>
+bool BasicInstrumentedTapeDev<T>::atEndOfTape() const noexcept {
+  return m_tape_dev->atEndOfTape();
+}
+
+template class BasicInstrumentedTapeDev<std::int32_t>;
+template class BasicInstrumentedTapeDev<std::int64_t>;
+template class BasicInstrumentedTapeDev<std::uint64_t>;
+template class BasicInstrumentedTapeDev<TapeRecord>;
@@ -0,0 +1,82 @@
+#ifndef INSTRUMENTED_TAPE_DEV_HPP
+#define INSTRUMENTED_TAPE_DEV_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+#include "ITapeDev.hpp"
+#include "TapeDevConfig.hpp"
+#include "TapeDevStats.hpp"
+
+/*
+ * Класс BasicInstrumentedTapeDev
+ *
+ * Обёртка над любым ленточным устройством, которая учитывает каждую операцию
+ * в TapeDevStats. Эмулируемое время операции вычисляется по задержкам из
+ * конфигурации устройства, реальное время измеряется вокруг вызова
+ * операции обёрнутого устройства.
+ *
+ * Блочные операции учитываются как соответствующее количество чтений
+ * (записей) и сдвигов вправо. Реальное время блочной операции целиком
+ * относится к чтению (записи).
+ */
+template <typename T>
+class BasicInstrumentedTapeDev final : public IBasicTapeDev<T> {
+ public:
+  /// Создаёт обёртку над переданным устройством, на которое установлена лента,
+  /// расположенная по переданному пути.
+  BasicInstrumentedTapeDev(std::unique_ptr<IBasicTapeDev<T>>, const std::filesystem::path&,
+                           const TapeDevConfig&, TapeDevOperationMode, TapeDevStats&) noexcept;
+
+  T read() override;
+
+  void write(T) override;
+
+  void shiftLeft() override;
+
+  void shiftRight() override;
+
+  void rewind() override;
+
+  /// Учитывает перемещение головки как сдвиги вправо или влево на
+  /// пройденное количество ячеек.
+  void seekToCell(size_t) override;
+
+  size_t readBlock(T* t_buf, size_t t_count) override;
+
+  void writeBlock(const T* t_buf, size_t t_count) override;
+
+  void flush() override;
+
+  size_t getHeadPos() const noexcept override;
+
+  bool atStartOfTape() const noexcept override;
+
+  bool atEndOfTape() const noexcept override;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// Учитывает операцию, начатую в переданный момент времени.
+  void record(TapeDevOperation, uint64_t, uint64_t, Clock::time_point);
+
+  /// Обёрнутое устройство.
+  std::unique_ptr<IBasicTapeDev<T>> m_tape_dev;
+
+  /// Путь к файлу ленты, по которому ведётся статистика.
+  const std::filesystem::path m_tape_file_path;
+
+  /// Конфигурация устройства с задержками операций.
+  const TapeDevConfig m_dev_config;
+
+  /// Режим работы устройства.
+  const TapeDevOperationMode m_operation_mode;
+
+  /// Статистика, в которой учитываются операции.
+  TapeDevStats& m_stats;
+};
+
+using InstrumentedTapeDev = BasicInstrumentedTapeDev<int>;
+
+#endif  // INSTRUMENTED_TAPE_DEV_HPP
@@ -0,0 +1,277 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "MappedTapeDev.hpp"
+#include "TapeDevExceptions.hpp"
+
+template <typename T>
+BasicMappedTapeDev<T>::BasicMappedTapeDev(const std::filesystem::path& t_tape_file_path,
+                                          const TapeDevConfig& t_dev_config,
+                                          const TapeDevOperationMode t_mode)
+    : m_tape_file_path(t_tape_file_path),
+      m_dev_config(t_dev_config),
+      m_fd(-1),
+      m_data(nullptr),
+      m_size(0),
+      m_cell_offsets(),
+      m_fully_indexed_flag(false),
+      m_head_pos(0) {
+  if (t_mode != TapeDevOperationMode::Read) {
+    throw InvalidOperationException(
+        "Устройство MappedTapeDev поддерживает только режим TapeDevOperationMode::Read.");
+  }
+
+  m_fd = ::open(m_tape_file_path.c_str(), O_RDONLY);
+  if (m_fd < 0) {
+    throw BadTapeException("Не удалось отктыть файл ленты '" + m_tape_file_path.string() +
+                           "': " + std::strerror(errno) + ".");
+  }
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0) {
+    ::close(m_fd);
+    throw BadTapeException("Не удалось определить размер файла ленты '" +
+                           m_tape_file_path.string() + "'.");
+  }
+  m_size = static_cast<size_t>(st.st_size);
+
+  // Пустой файл отобразить в память нельзя, но это и не требуется: на ленте
+  // нет ни одной ячейки.
+  if (m_size > 0) {
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(m_fd);
+      throw BadTapeException("Не удалось отобразить в память файл ленты '" +
+                             m_tape_file_path.string() + "'.");
+    }
+    // Лента читается последовательно, о чём сообщаем ядру для упреждающего
+    // чтения.
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+  }
+
+  try {
+    indexNextCell();
+  } catch (const BadTapeException& e) {
+    unmap();
+    throw;
+  }
+}
+
+template <typename T>
+bool BasicMappedTapeDev<T>::indexNextCell() {
+  if (m_fully_indexed_flag) {
+    return false;
+  }
+
+  size_t pos = 0;
+  if (!m_cell_offsets.empty()) {
+    // Пропускаем значение последней проиндексированной ячейки.
+    pos = m_cell_offsets.back();
+    while (pos < m_size && TapeCellCodec<T>::isValueChar(m_data[pos])) {
+      ++pos;
+    }
+  }
+
+  while (pos < m_size && std::isspace(static_cast<unsigned char>(m_data[pos]))) {
+    ++pos;
+  }
+
+  if (pos == m_size) {
+    m_fully_indexed_flag = true;
+    return false;
+  }
+
+  if (!TapeCellCodec<T>::isValueChar(m_data[pos])) {
+    throw BadTapeException("Недопустимый символ на ленте: '" + std::string(1, m_data[pos]) +
+                           "'.");
+  }
+
+  m_cell_offsets.push_back(pos);
+  return true;
+}
+
+template <typename T>
+T BasicMappedTapeDev<T>::read() {
+  if (atEndOfTape()) {
+    throw EndOfTapeException();
+  }
+
+  const T value = parseCell(m_cell_offsets.at(m_head_pos));
+
+  // Эмулируем время, необходимое устройству для выполнения чтения с ленты.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.read_delay);
+
+  return value;
+}
+
+template <typename T>
+T BasicMappedTapeDev<T>::parseCell(size_t t_offset) const {
+  // Недопустимые символы внутри значения обнаруживаются при его разборе.
+  size_t pos = t_offset;
+  while (pos < m_size && !std::isspace(static_cast<unsigned char>(m_data[pos]))) {
+    ++pos;
+  }
+
+  return TapeCellCodec<T>::parse(m_data + t_offset, m_data + pos);
+}
+
+template <typename T>
+size_t BasicMappedTapeDev<T>::readBlock(T* t_buf, size_t t_count) {
+  size_t num_read_values = 0;
+
+  if (t_count > 0 && !atEndOfTape()) {
+    const size_t block_start = m_cell_offsets.at(m_head_pos);
+    const size_t num_indexed_cells = m_cell_offsets.size();
+
+    // Смещения значений блока записываются прямо в индекс ячеек. Уже
+    // проиндексированные смещения при этом не меняются.
+    m_cell_offsets.resize(std::max(num_indexed_cells, m_head_pos + t_count));
+    TextCellsParseResult res;
+    try {
+      res = TapeCellCodec<T>::parseBlock(m_data + block_start, m_size - block_start, t_buf,
+                                         t_count, true, m_cell_offsets.data() + m_head_pos);
+    } catch (const BadTapeException& e) {
+      m_cell_offsets.resize(num_indexed_cells);
+      throw;
+    }
+    num_read_values = res.num_values;
+    for (size_t i = m_head_pos; i < m_head_pos + num_read_values; ++i) {
+      m_cell_offsets[i] += block_start;
+    }
+    m_cell_offsets.resize(std::max(num_indexed_cells, m_head_pos + num_read_values));
+
+    // Блок закончился раньше, чем было считано запрошенное количество
+    // значений, только если разобрана вся оставшаяся часть ленты.
+    if (num_read_values < t_count) {
+      m_fully_indexed_flag = true;
+    }
+
+    m_head_pos += num_read_values;
+    if (m_head_pos == m_cell_offsets.size()) {
+      indexNextCell();
+    }
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения чтения и сдвига
+  // для каждой ячейки блока.
+  emulateTapeDevDelay(m_dev_config,
+                      (m_dev_config.read_delay + m_dev_config.shift_delay) * num_read_values);
+
+  return num_read_values;
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::writeBlock(const T*, size_t) {
+  throw InvalidOperationException("Запись невозможна. Устройство работает в режиме только чтение.");
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::flush() {}
+
+template <typename T>
+void BasicMappedTapeDev<T>::write(T) {
+  throw InvalidOperationException("Запись невозможна. Устройство работает в режиме только чтение.");
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::shiftLeft() {
+  if (m_head_pos == 0) {
+    return;
+  }
+
+  m_head_pos -= 1;
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию влево.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::shiftRight() {
+  if (atEndOfTape()) {
+    return;
+  }
+
+  m_head_pos += 1;
+
+  // Индексируем ячейку, на которую переместилась головка, чтобы сразу знать,
+  // не достигнут ли конец ленты.
+  if (m_head_pos == m_cell_offsets.size()) {
+    indexNextCell();
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию вправо.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::rewind() {
+  m_head_pos = 0;
+
+  // Эмулируем время, необходимое устройству для выполнения перемотки ленты в
+  // начало.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.rewind_delay);
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::seekToCell(size_t t_cell) {
+  // Индексируем ячейки до целевой, чтобы знать, есть ли она на ленте.
+  while (m_cell_offsets.size() <= t_cell && indexNextCell()) {
+  }
+
+  const size_t head_pos = m_head_pos;
+  m_head_pos = std::min(t_cell, m_cell_offsets.size());
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на каждую
+  // ячейку пройденного расстояния.
+  const size_t distance = m_head_pos > head_pos ? m_head_pos - head_pos : head_pos - m_head_pos;
+  emulateTapeDevDelay(m_dev_config,
+                      m_dev_config.shift_delay * static_cast<long long>(distance));
+}
+
+template <typename T>
+size_t BasicMappedTapeDev<T>::getHeadPos() const noexcept {
+  return m_head_pos;
+}
+
+template <typename T>
+bool BasicMappedTapeDev<T>::atStartOfTape() const noexcept {
+  return m_head_pos == 0;
+}
+
+template <typename T>
+bool BasicMappedTapeDev<T>::atEndOfTape() const noexcept {
+  return m_fully_indexed_flag && m_head_pos >= m_cell_offsets.size();
+}
+
+template <typename T>
+void BasicMappedTapeDev<T>::unmap() noexcept {
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+template <typename T>
+BasicMappedTapeDev<T>::~BasicMappedTapeDev() noexcept {
+  unmap();
+}
+
+template class BasicMappedTapeDev<std::int32_t>;
+template class BasicMappedTapeDev<std::int64_t>;
+template class BasicMappedTapeDev<std::uint64_t>;
+template class BasicMappedTapeDev<TapeRecord>;
@@ -0,0 +1,112 @@
+#ifndef MAPPED_TAPE_DEV_HPP
+#define MAPPED_TAPE_DEV_HPP
+
+#include <filesystem>
+#include <vector>
+
+#include "ITapeDev.hpp"
+#include "TapeCellCodec.hpp"
+#include "TapeDevConfig.hpp"
+
+/*
+ * Класс BasicMappedTapeDev
+ *
+ * Ленточное устройство для чтения лент в текстовом формате, которое отображает
+ * файл ленты в память (mmap) вместо посимвольного чтения через std::fstream.
+ * Устройство поддерживает индекс смещений ячеек, который строится по мере
+ * продвижения головки вправо, поэтому сдвиги головки влево и перемотка не
+ * требуют повторного разбора файла ленты.
+ *
+ * Устройство работает только в режиме TapeDevOperationMode::Read. Задержки из
+ * конфигурации устройства эмулируются так же, как и в TapeDev. Устройство для
+ * ячеек типа 'int' доступно под именем MappedTapeDev.
+ */
+template <typename T>
+class BasicMappedTapeDev final : public IBasicTapeDev<T> {
+ public:
+  /// Отображает файл ленты в память.
+  ///
+  /// Если файл ленты не удалось открыть или отобразить в память, выбрасывает
+  /// BadTapeException. Если передан режим работы, отличный от
+  /// TapeDevOperationMode::Read, выбрасывает InvalidOperationException.
+  BasicMappedTapeDev(const std::filesystem::path&, const TapeDevConfig&,
+                     const TapeDevOperationMode);
+
+  BasicMappedTapeDev(const BasicMappedTapeDev&) = delete;
+
+  BasicMappedTapeDev& operator=(const BasicMappedTapeDev&) = delete;
+
+  /// Считывает значение из ячейки на текущей позиции головки. При попытке
+  /// чтения за концом ленты выбрасывает EndOfTapeException, при обнаружении
+  /// недопустимого значения - BadTapeException.
+  T read() override;
+
+  /// Запись не поддерживается: всегда выбрасывает InvalidOperationException.
+  void write(T) override;
+
+  void shiftLeft() override;
+
+  void shiftRight() override;
+
+  void rewind() override;
+
+  /// Использует индекс смещений ячеек устройства, дополняя его до
+  /// переданной ячейки, если она ещё не проиндексирована.
+  void seekToCell(size_t) override;
+
+  /// Разбирает блок ячеек прямо из отображённого в память файла ленты.
+  size_t readBlock(T*, size_t) override;
+
+  /// Запись не поддерживается: всегда выбрасывает InvalidOperationException.
+  void writeBlock(const T*, size_t) override;
+
+  /// Запись не поддерживается, поэтому ничего не делает.
+  void flush() override;
+
+  size_t getHeadPos() const noexcept override;
+
+  bool atStartOfTape() const noexcept override;
+
+  bool atEndOfTape() const noexcept override;
+
+  ~BasicMappedTapeDev() noexcept;
+
+ private:
+  /// Находит начало ячейки, следующей за последней проиндексированной, и
+  /// добавляет его в индекс. Возвращает false, если на ленте больше нет ячеек.
+  bool indexNextCell();
+
+  /// Разбирает значение ячейки, начинающейся с переданного смещения.
+  T parseCell(size_t) const;
+
+  /// Снимает отображение файла ленты в память и закрывает файл.
+  void unmap() noexcept;
+
+  /// Путь к файлу ленты.
+  std::filesystem::path m_tape_file_path;
+
+  /// Объект, который хранит конфигурацию устройства.
+  const TapeDevConfig m_dev_config;
+
+  /// Файловый дескриптор файла ленты.
+  int m_fd;
+
+  /// Отображённое в память содержимое файла ленты.
+  const char* m_data;
+
+  /// Размер файла ленты в байтах.
+  size_t m_size;
+
+  /// Смещения начала значений проиндексированных ячеек ленты.
+  std::vector<size_t> m_cell_offsets;
+
+  /// Показывает, что все ячейки ленты проиндексированы.
+  bool m_fully_indexed_flag;
+
+  /// Текущая позиция считывающей/записыващей магнитной головки на ленте.
+  size_t m_head_pos;
+};
+
+using MappedTapeDev = BasicMappedTapeDev<int>;
+
+#endif  // MAPPED_TAPE_DEV_HPP
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <string>
+
+#include "MemoryArena.hpp"
+#include "TapeDevExceptions.hpp"
+
+MemoryArena::MemoryArena(size_t t_capacity) noexcept
+    : m_capacity(t_capacity),
+      m_used_bytes(0),
+      m_peak_bytes(0),
+      m_upstream(std::pmr::new_delete_resource()) {}
+
+void MemoryArena::charge(size_t t_bytes, const char* t_what) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_capacity != 0 && t_bytes > m_capacity - m_used_bytes) {
+    throw MemoryLimitExceededException(
+        "Превышено ограничение рабочей памяти сортировщика (MemoryLimit): для " +
+        std::string(t_what) + " требуется " + std::to_string(t_bytes) + " байт, занято " +
+        std::to_string(m_used_bytes) + " из " + std::to_string(m_capacity) + " байт.");
+  }
+
+  m_used_bytes += t_bytes;
+  if (m_used_bytes > m_peak_bytes) {
+    m_peak_bytes = m_used_bytes;
+  }
+}
+
+void MemoryArena::reserve(size_t t_bytes, const char* t_what) {
+  charge(t_bytes, t_what);
+}
+
+void MemoryArena::unreserve(size_t t_bytes) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_used_bytes -= std::min(t_bytes, m_used_bytes);
+}
+
+size_t MemoryArena::getCapacity() const noexcept {
+  return m_capacity;
+}
+
+size_t MemoryArena::getUsedBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_used_bytes;
+}
+
+size_t MemoryArena::getPeakBytes() const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_peak_bytes;
+}
+
+void MemoryArena::resetPeak() noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_peak_bytes = m_used_bytes;
+}
+
+void* MemoryArena::do_allocate(size_t t_bytes, size_t t_alignment) {
+  charge(t_bytes, "контейнера сортировщика");
+  try {
+    return m_upstream->allocate(t_bytes, t_alignment);
+  } catch (...) {
+    unreserve(t_bytes);
+    throw;
+  }
+}
+
+void MemoryArena::do_deallocate(void* t_ptr, size_t t_bytes, size_t t_alignment) {
+  m_upstream->deallocate(t_ptr, t_bytes, t_alignment);
+  unreserve(t_bytes);
+}
+
+bool MemoryArena::do_is_equal(const std::pmr::memory_resource& t_other) const noexcept {
+  return this == &t_other;
+}
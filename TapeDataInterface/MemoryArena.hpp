@@ -0,0 +1,81 @@
+#ifndef MEMORY_ARENA_HPP
+#define MEMORY_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+/*
+ * Класс MemoryArena
+ *
+ * Арена рабочей памяти сортировщика: источник памяти для контейнеров
+ * std::pmr, который учитывает объём выделенной через него памяти и её пиковое
+ * значение. Если задана ёмкость арены, то запрос, после которого объём
+ * выделенной памяти превысил бы ёмкость, завершается исключением
+ * MemoryLimitExceededException, а память не выделяется.
+ *
+ * Память, которая выделена вне арены, но должна учитываться вместе с ней
+ * (например, буфер памяти основного устройства), учитывается методом
+ * reserve().
+ *
+ * Методы арены потокобезопасны.
+ */
+class MemoryArena final : public std::pmr::memory_resource {
+ public:
+  /// Создаёт арену с переданной ёмкостью в байтах. Ёмкость 0 означает
+  /// отсутствие ограничения: арена только учитывает выделенную память.
+  explicit MemoryArena(size_t) noexcept;
+
+  MemoryArena(const MemoryArena&) = delete;
+
+  MemoryArena& operator=(const MemoryArena&) = delete;
+
+  /// Учитывает переданное количество байт, выделенных вне арены. Второй
+  /// аргумент - описание памяти для сообщения об ошибке. Если ёмкость арены
+  /// будет превышена, выбрасывает MemoryLimitExceededException.
+  void reserve(size_t, const char*);
+
+  /// Перестаёт учитывать переданное количество байт, учтённых reserve().
+  void unreserve(size_t) noexcept;
+
+  /// Возвращает ёмкость арены в байтах (0 - без ограничения).
+  size_t getCapacity() const noexcept;
+
+  /// Возвращает объём учитываемой в данный момент памяти в байтах.
+  size_t getUsedBytes() const noexcept;
+
+  /// Возвращает пиковый объём учитываемой памяти в байтах с момента создания
+  /// арены или последнего вызова resetPeak().
+  size_t getPeakBytes() const noexcept;
+
+  /// Приравнивает пиковый объём памяти текущему.
+  void resetPeak() noexcept;
+
+ private:
+  void* do_allocate(size_t, size_t) override;
+
+  void do_deallocate(void*, size_t, size_t) override;
+
+  bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+
+  /// Учитывает переданное количество байт или выбрасывает
+  /// MemoryLimitExceededException, если ёмкость арены будет превышена.
+  void charge(size_t, const char*);
+
+  /// Ёмкость арены в байтах.
+  const size_t m_capacity;
+
+  /// Объём учитываемой памяти в байтах.
+  size_t m_used_bytes;
+
+  /// Пиковый объём учитываемой памяти в байтах.
+  size_t m_peak_bytes;
+
+  /// Защищает счётчики памяти.
+  mutable std::mutex m_mutex;
+
+  /// Источник, из которого выделяется память.
+  std::pmr::memory_resource* m_upstream;
+};
+
+#endif  // MEMORY_ARENA_HPP
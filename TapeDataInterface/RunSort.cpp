@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "RunSort.hpp"
+
+namespace {
+
+constexpr size_t kRadixBits = 8;
+constexpr size_t kRadixBuckets = 1 << kRadixBits;
+
+/// Поразрядная сортировка (см. radixSortRun()). Направление сортировки
+/// задаётся во время компиляции, чтобы сортировка по возрастанию не тратила
+/// время на инвертирование ключей.
+template <bool kDescending, typename T>
+void radixSortRunImpl(T* t_values, size_t t_num_values, T* t_scratch) noexcept {
+  using Codec = TapeCellCodec<T>;
+  using RadixKey = typename Codec::RadixKey;
+  constexpr size_t kRadixPasses = sizeof(RadixKey) * 8 / kRadixBits;
+
+  // Инвертирование ключа меняет порядок на обратный.
+  const auto radix_key = [](const T& t_value) -> RadixKey {
+    if constexpr (kDescending) {
+      return static_cast<RadixKey>(~Codec::radixKey(t_value));
+    } else {
+      return Codec::radixKey(t_value);
+    }
+  };
+
+  // Гистограммы всех байтов строятся за один проход по отрезку.
+  std::array<std::array<size_t, kRadixBuckets>, kRadixPasses> counts{};
+  for (size_t i = 0; i < t_num_values; ++i) {
+    const RadixKey key = radix_key(t_values[i]);
+    for (size_t pass = 0; pass < kRadixPasses; ++pass) {
+      counts[pass][(key >> (pass * kRadixBits)) & (kRadixBuckets - 1)] += 1;
+    }
+  }
+
+  T* src = t_values;
+  T* dst = t_scratch;
+  for (size_t pass = 0; pass < kRadixPasses; ++pass) {
+    std::array<size_t, kRadixBuckets>& pass_counts = counts[pass];
+    const size_t shift = pass * kRadixBits;
+
+    // Если у всех значений байт одинаков, проход не меняет порядок.
+    if (pass_counts[(radix_key(src[0]) >> shift) & (kRadixBuckets - 1)] == t_num_values) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (size_t& count : pass_counts) {
+      const size_t bucket_size = count;
+      count = offset;
+      offset += bucket_size;
+    }
+
+    for (size_t i = 0; i < t_num_values; ++i) {
+      const T value = src[i];
+      dst[pass_counts[(radix_key(value) >> shift) & (kRadixBuckets - 1)]++] = value;
+    }
+
+    std::swap(src, dst);
+  }
+
+  if (src != t_values) {
+    std::copy(src, src + t_num_values, t_values);
+  }
+}
+
+/// Количество старших бит тега, в которых хранится префикс ключа.
+constexpr size_t kTagPrefixBits = 32;
+
+/// Маска младших бит тега, в которых хранится номер значения в отрезке.
+constexpr std::uint64_t kTagIndexMask = (std::uint64_t(1) << kTagPrefixBits) - 1;
+
+/// Возвращает размер буфера тегов для поразрядной сортировки по тегам
+/// отрезка из переданного количества значений: теги, а затем область,
+/// которая сначала служит вспомогательным буфером сортировки тегов, а затем
+/// вмещает отсортированные значения.
+template <typename T>
+constexpr size_t tagScratchSize(size_t t_num_values) noexcept {
+  static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(std::uint64_t) == 0);
+  return t_num_values + t_num_values * (sizeof(T) / sizeof(std::uint64_t));
+}
+
+/// Возвращает количество значащих бит переданного числа.
+size_t bitWidth(std::uint64_t t_value) noexcept {
+  return t_value == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(t_value));
+}
+
+/// Устойчиво сортирует теги по префиксу ключа (старшим kTagPrefixBits битам)
+/// поразрядной сортировкой. Третий аргумент - вспомогательный буфер размером
+/// не меньше количества тегов.
+void radixSortTagPrefixes(std::uint64_t* t_tags, size_t t_num_tags,
+                          std::uint64_t* t_scratch) noexcept {
+  constexpr size_t kFirstPass = (64 - kTagPrefixBits) / kRadixBits;
+  constexpr size_t kRadixPasses = 64 / kRadixBits;
+
+  std::array<std::array<size_t, kRadixBuckets>, kRadixPasses> counts{};
+  for (size_t i = 0; i < t_num_tags; ++i) {
+    const std::uint64_t tag = t_tags[i];
+    for (size_t pass = kFirstPass; pass < kRadixPasses; ++pass) {
+      counts[pass][(tag >> (pass * kRadixBits)) & (kRadixBuckets - 1)] += 1;
+    }
+  }
+
+  std::uint64_t* src = t_tags;
+  std::uint64_t* dst = t_scratch;
+  for (size_t pass = kFirstPass; pass < kRadixPasses; ++pass) {
+    std::array<size_t, kRadixBuckets>& pass_counts = counts[pass];
+    const size_t shift = pass * kRadixBits;
+
+    if (pass_counts[(src[0] >> shift) & (kRadixBuckets - 1)] == t_num_tags) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (size_t& count : pass_counts) {
+      const size_t bucket_size = count;
+      count = offset;
+      offset += bucket_size;
+    }
+
+    for (size_t i = 0; i < t_num_tags; ++i) {
+      const std::uint64_t tag = src[i];
+      dst[pass_counts[(tag >> shift) & (kRadixBuckets - 1)]++] = tag;
+    }
+
+    std::swap(src, dst);
+  }
+
+  if (src != t_tags) {
+    std::copy(src, src + t_num_tags, t_tags);
+  }
+}
+
+/// Поразрядная сортировка по тегам (см. kRadixSortByTags). Значения больше
+/// своего ключа, поэтому вместо значений сортируются 64-битные теги: в
+/// старших битах тега - префикс ключа, в младших - номер значения в отрезке.
+/// Префикс - kTagPrefixBits бит ключа, начиная со старшего бита, в котором
+/// различаются наименьший и наибольший ключи отрезка, поэтому для отрезков с
+/// небольшим разбросом ключей префикс совпадает с ключом целиком. Значения с
+/// одинаковыми префиксами, но разными ключами упорядочиваются сравнением
+/// полных ключей. Затем значения собираются в порядке тегов во
+/// вспомогательный буфер и копируются обратно в отрезок. Первый аргумент
+/// шаблона совпадает с radixSortRunImpl(). Третий аргумент - буфер тегов
+/// размером не меньше tagScratchSize().
+template <bool kDescending, typename T>
+void radixSortRunByTags(T* t_values, size_t t_num_values, std::uint64_t* t_tags) noexcept {
+  using Codec = TapeCellCodec<T>;
+  using RadixKey = typename Codec::RadixKey;
+  static_assert(sizeof(RadixKey) <= sizeof(std::uint64_t));
+
+  const auto radix_key = [t_values](size_t t_idx) -> std::uint64_t {
+    if constexpr (kDescending) {
+      return static_cast<RadixKey>(~Codec::radixKey(t_values[t_idx]));
+    } else {
+      return Codec::radixKey(t_values[t_idx]);
+    }
+  };
+
+  std::uint64_t min_key = radix_key(0);
+  std::uint64_t max_key = min_key;
+  for (size_t i = 1; i < t_num_values; ++i) {
+    const std::uint64_t key = radix_key(i);
+    min_key = std::min(min_key, key);
+    max_key = std::max(max_key, key);
+  }
+
+  // Все ключи отрезка совпадают со старшими битами наименьшего и
+  // наибольшего ключей, в которых те не различаются, поэтому эти биты в
+  // префикс не входят.
+  const size_t key_bits = bitWidth(min_key ^ max_key);
+  if (key_bits == 0) {
+    return;
+  }
+  const size_t prefix_shift = key_bits > kTagPrefixBits ? key_bits - kTagPrefixBits : 0;
+
+  std::uint64_t* tags = t_tags;
+  for (size_t i = 0; i < t_num_values; ++i) {
+    tags[i] = ((radix_key(i) >> prefix_shift) << kTagPrefixBits) | i;
+  }
+  radixSortTagPrefixes(tags, t_num_values, t_tags + t_num_values);
+
+  // Префикс отбросил младшие биты ключей: группы тегов с одинаковыми
+  // префиксами досортировываются по полным ключам, а при равенстве ключей -
+  // по номерам значений, что сохраняет устойчивость.
+  if (prefix_shift != 0) {
+    const auto tag_less = [&radix_key](std::uint64_t t_lhs, std::uint64_t t_rhs) {
+      const std::uint64_t lhs_key = radix_key(t_lhs & kTagIndexMask);
+      const std::uint64_t rhs_key = radix_key(t_rhs & kTagIndexMask);
+      return lhs_key < rhs_key || (lhs_key == rhs_key && t_lhs < t_rhs);
+    };
+    size_t group_begin = 0;
+    for (size_t i = 1; i <= t_num_values; ++i) {
+      const std::uint64_t group_prefix = tags[group_begin] >> kTagPrefixBits;
+      if (i < t_num_values && tags[i] >> kTagPrefixBits == group_prefix) {
+        continue;
+      }
+      if (i - group_begin > 1) {
+        std::sort(tags + group_begin, tags + i, tag_less);
+      }
+      group_begin = i;
+    }
+  }
+
+  // Тег на позиции i содержит номер значения, которое должно оказаться на
+  // позиции i. Значения собираются в этом порядке в освободившуюся часть
+  // буфера тегов: загрузки значений независимы друг от друга, поэтому
+  // промахи кеша при произвольном доступе перекрываются, чего не происходит
+  // при перестановке значений на месте по циклам перестановки.
+  unsigned char* sorted_values = reinterpret_cast<unsigned char*>(t_tags + t_num_values);
+  for (size_t i = 0; i < t_num_values; ++i) {
+    std::memcpy(sorted_values + i * sizeof(T), t_values + (tags[i] & kTagIndexMask), sizeof(T));
+  }
+  std::memcpy(t_values, sorted_values, t_num_values * sizeof(T));
+}
+
+/// Сортирует отрезок сравнениями. Записи TapeRecord с равными ключами
+/// сохраняют исходный порядок, как и при поразрядной сортировке, иначе
+/// порядок записей в результате зависел бы от выбранного алгоритма. Равные
+/// целые числа неразличимы, поэтому для них используется более быстрая
+/// неустойчивая сортировка.
+template <typename T, typename Compare>
+void comparisonSortRun(T* t_values, size_t t_num_values, Compare t_compare) {
+  if constexpr (std::is_integral_v<T>) {
+    std::sort(t_values, t_values + t_num_values, t_compare);
+  } else {
+    std::stable_sort(t_values, t_values + t_num_values, t_compare);
+  }
+}
+
+}  // namespace
+
+template <typename T, typename Compare>
+void sortRun(T* t_values, size_t t_num_values, RunSortKernel t_kernel,
+             RunSortScratch<T>& t_scratch, Compare t_compare) {
+  if constexpr (!kRadixSortableOrder<T, Compare>) {
+    comparisonSortRun(t_values, t_num_values, t_compare);
+  } else {
+    const bool use_radix =
+        t_kernel == RunSortKernel::Radix ||
+        (t_kernel == RunSortKernel::Auto && t_num_values >= kRadixSortMinRunSize);
+
+    // Номер значения в отрезке должен помещаться в младшие биты тега.
+    constexpr bool kSortByTags = kRadixSortByTags<T>;
+    if (!use_radix || (kSortByTags && t_num_values > kTagIndexMask)) {
+      comparisonSortRun(t_values, t_num_values, t_compare);
+      return;
+    }
+
+    size_t scratch_size = t_num_values;
+    if constexpr (kSortByTags) {
+      scratch_size = tagScratchSize<T>(t_num_values);
+    }
+    if (t_scratch.size() < scratch_size) {
+      try {
+        t_scratch.resize(scratch_size);
+      } catch (const std::bad_alloc& e) {
+        if (t_kernel != RunSortKernel::Auto) {
+          throw;
+        }
+        comparisonSortRun(t_values, t_num_values, t_compare);
+        return;
+      }
+    }
+    constexpr bool kDescending = std::is_same_v<Compare, std::greater<T>>;
+    if constexpr (kSortByTags) {
+      if (t_num_values >= 2) {
+        radixSortRunByTags<kDescending>(t_values, t_num_values, t_scratch.data());
+      }
+    } else {
+      radixSortRun(t_values, t_num_values, t_scratch.data(), kDescending);
+    }
+  }
+}
+
+template <typename T>
+void radixSortRun(T* t_values, size_t t_num_values, T* t_scratch, bool t_descending) noexcept {
+  if (t_num_values < 2) {
+    return;
+  }
+
+  if (t_descending) {
+    radixSortRunImpl<true>(t_values, t_num_values, t_scratch);
+  } else {
+    radixSortRunImpl<false>(t_values, t_num_values, t_scratch);
+  }
+}
+
+template void sortRun(std::int32_t*, size_t, RunSortKernel, RunSortScratch<std::int32_t>&,
+                      std::less<std::int32_t>);
+template void sortRun(std::int32_t*, size_t, RunSortKernel, RunSortScratch<std::int32_t>&,
+                      std::greater<std::int32_t>);
+template void sortRun(std::int64_t*, size_t, RunSortKernel, RunSortScratch<std::int64_t>&,
+                      std::less<std::int64_t>);
+template void sortRun(std::uint64_t*, size_t, RunSortKernel, RunSortScratch<std::uint64_t>&,
+                      std::less<std::uint64_t>);
+template void sortRun(TapeRecord*, size_t, RunSortKernel, RunSortScratch<TapeRecord>&,
+                      std::less<TapeRecord>);
+
+template void radixSortRun(std::int32_t*, size_t, std::int32_t*, bool) noexcept;
+template void radixSortRun(std::int64_t*, size_t, std::int64_t*, bool) noexcept;
+template void radixSortRun(std::uint64_t*, size_t, std::uint64_t*, bool) noexcept;
+template void radixSortRun(TapeRecord*, size_t, TapeRecord*, bool) noexcept;
@@ -0,0 +1,69 @@
+#ifndef RUN_SORT_HPP
+#define RUN_SORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include "TapeCellCodec.hpp"
+#include "TapeDevConfig.hpp"
+
+/// Минимальный размер отрезка, начиная с которого RunSortKernel::Auto
+/// выбирает поразрядную сортировку. На меньших отрезках сортировка
+/// сравнениями быстрее: поразрядной сортировке требуется обнулить и
+/// просуммировать гистограммы независимо от размера отрезка.
+inline constexpr size_t kRadixSortMinRunSize = 1024;
+
+/// Показывает, что порядок, задаваемый компаратором, совпадает с порядком
+/// ключей TapeCellCodec<T>::radixKey() по возрастанию или по убыванию, то
+/// есть отрезок можно сортировать поразрядной сортировкой.
+template <typename T, typename Compare>
+inline constexpr bool kRadixSortableOrder =
+    std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::greater<T>>;
+
+/// Показывает, что значения типа T больше своего ключа поразрядной
+/// сортировки (записи TapeRecord с полезной нагрузкой). Такие отрезки
+/// поразрядная сортировка упорядочивает не целиком, а по компактным 64-битным
+/// тегам "префикс ключа, номер значения в отрезке", после чего значения
+/// собираются в порядке отсортированных тегов.
+template <typename T>
+inline constexpr bool kRadixSortByTags = sizeof(T) > sizeof(typename TapeCellCodec<T>::RadixKey);
+
+/// Вспомогательный буфер sortRun(): буфер тегов для значений, которые
+/// сортируются по тегам (см. kRadixSortByTags), иначе буфер значений.
+template <typename T>
+using RunSortScratch =
+    std::pmr::vector<std::conditional_t<kRadixSortByTags<T>, std::uint64_t, T>>;
+
+/// Сортирует переданный отрезок значений выбранным алгоритмом в порядке,
+/// заданном компаратором. Аргументы: указатель на начало отрезка, количество
+/// значений, алгоритм, вспомогательный буфер поразрядной сортировки и
+/// компаратор. Размер вспомогательного буфера при необходимости
+/// увеличивается до размера отрезка, поэтому буфер следует переиспользовать
+/// между вызовами. Если отрезок сортируется по тегам, буфер вмещает теги и
+/// копию отрезка, то есть занимает в полтора раза больше памяти, чем при
+/// поразрядной сортировке записей TapeRecord целиком. Сортировка по тегам,
+/// как и radixSortRun(), устойчива; записи TapeRecord сортируются устойчиво
+/// и сравнениями, поэтому результат не зависит от алгоритма.
+///
+/// Если вспомогательный буфер не удалось увеличить (например, из-за
+/// ограничения памяти арены, из которой он выделяется), RunSortKernel::Auto
+/// сортирует отрезок сравнениями, а RunSortKernel::Radix выбрасывает
+/// std::bad_alloc. Если порядок компаратора не сводится к порядку ключей
+/// поразрядной сортировки (см. kRadixSortableOrder), отрезок всегда
+/// сортируется сравнениями.
+template <typename T, typename Compare = std::less<T>>
+void sortRun(T*, size_t, RunSortKernel, RunSortScratch<T>&, Compare = Compare());
+
+/// Сортирует отрезок значений поразрядной сортировкой (LSD, по байтам ключа
+/// TapeCellCodec<T>::radixKey()) по возрастанию или, если передан флаг, по
+/// убыванию. Третий аргумент - вспомогательный буфер размером не меньше
+/// размера отрезка. Проходы по байтам, значения которых совпадают у всех
+/// элементов, пропускаются. Сортировка устойчива.
+template <typename T>
+void radixSortRun(T*, size_t, T*, bool = false) noexcept;
+
+#endif  // RUN_SORT_HPP
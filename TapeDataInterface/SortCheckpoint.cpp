@@ -0,0 +1,181 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "SortCheckpoint.hpp"
+#include "utils.hpp"
+
+namespace {
+
+/// Имя файла манифеста в каталоге временных лент.
+const char* const kManifestFileName = "sort_checkpoint.txt";
+
+/// Разбирает неотрицательное целое число. Возвращает false, если строка не
+/// является числом.
+bool parseNumber(const std::string& t_str, std::uintmax_t& t_value) {
+  if (t_str.empty() || t_str.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  try {
+    t_value = std::stoull(t_str);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+/// Разбирает список неотрицательных целых чисел, разделённых пробелами.
+template <typename Vector>
+bool parseNumberList(const std::string& t_str, Vector& t_values) {
+  t_values.clear();
+  std::istringstream stream(t_str);
+  std::string item;
+  while (stream >> item) {
+    std::uintmax_t value = 0;
+    if (!parseNumber(item, value)) {
+      return false;
+    }
+    t_values.push_back(static_cast<typename Vector::value_type>(value));
+  }
+  return true;
+}
+
+/// Записывает список значений через пробел.
+template <typename Vector>
+void writeNumberList(std::ostream& t_stream, const Vector& t_values) {
+  for (size_t i = 0; i < t_values.size(); ++i) {
+    t_stream << (i == 0 ? "" : " ") << static_cast<std::uintmax_t>(t_values[i]);
+  }
+}
+
+}  // namespace
+
+SortCheckpoint::SortCheckpoint(std::pmr::memory_resource* t_memory_resource)
+    : input_size(0),
+      input_cells(0),
+      runs_complete(false),
+      run_sizes(t_memory_resource),
+      runs_sorted(t_memory_resource),
+      merge_output_cells(0),
+      merge_output_bytes(0),
+      merge_consumed(t_memory_resource) {}
+
+std::filesystem::path SortCheckpoint::manifestPath(const std::filesystem::path& t_data_dir_path) {
+  return t_data_dir_path / "var" / "tmp" / kManifestFileName;
+}
+
+bool SortCheckpoint::load(const std::filesystem::path& t_manifest_path) {
+  std::ifstream manifest(t_manifest_path);
+  if (!manifest.is_open()) {
+    return false;
+  }
+
+  const std::runtime_error corrupted("повреждён манифест контрольной точки '" +
+                                     t_manifest_path.string() + "'.");
+
+  std::string line;
+  while (std::getline(manifest, line)) {
+    if (trim_copy(line).empty()) {
+      continue;
+    }
+    if (line.find(':') == std::string::npos) {
+      throw corrupted;
+    }
+
+    const std::string value = trim_copy(splitAfterDelimiter(line));
+    std::uintmax_t number = 0;
+    bool ok = true;
+    if (stringStartsWith(line, "InputTape:")) {
+      input_tape = value;
+    } else if (stringStartsWith(line, "InputSize:")) {
+      ok = parseNumber(value, input_size);
+    } else if (stringStartsWith(line, "OutputTape:")) {
+      output_tape = value;
+    } else if (stringStartsWith(line, "CellType:")) {
+      cell_type = value;
+    } else if (stringStartsWith(line, "Order:")) {
+      order = value;
+    } else if (stringStartsWith(line, "TempTapeExtension:")) {
+      temp_tape_extension = value;
+    } else if (stringStartsWith(line, "InputCells:")) {
+      ok = parseNumber(value, number);
+      input_cells = static_cast<size_t>(number);
+    } else if (stringStartsWith(line, "RunsComplete:")) {
+      ok = parseNumber(value, number) && number <= 1;
+      runs_complete = number == 1;
+    } else if (stringStartsWith(line, "RunSizes:")) {
+      ok = parseNumberList(value, run_sizes);
+    } else if (stringStartsWith(line, "RunsSorted:")) {
+      ok = parseNumberList(value, runs_sorted);
+    } else if (stringStartsWith(line, "MergeOutputCells:")) {
+      ok = parseNumber(value, number);
+      merge_output_cells = static_cast<size_t>(number);
+    } else if (stringStartsWith(line, "MergeOutputBytes:")) {
+      ok = parseNumber(value, merge_output_bytes);
+    } else if (stringStartsWith(line, "MergeConsumed:")) {
+      ok = parseNumberList(value, merge_consumed);
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      throw corrupted;
+    }
+  }
+
+  if (runs_sorted.size() != run_sizes.size() ||
+      (!merge_consumed.empty() && merge_consumed.size() != run_sizes.size())) {
+    throw corrupted;
+  }
+
+  // С временной ленты нельзя записать на выходную ленту больше значений,
+  // чем содержит её отрезок.
+  for (size_t i = 0; i < merge_consumed.size(); ++i) {
+    if (merge_consumed[i] > run_sizes[i]) {
+      throw corrupted;
+    }
+  }
+
+  return true;
+}
+
+void SortCheckpoint::save(const std::filesystem::path& t_manifest_path) const {
+  std::filesystem::path new_manifest_path = t_manifest_path;
+  new_manifest_path += ".new";
+
+  {
+    std::ofstream manifest(new_manifest_path, std::ios::out | std::ios::trunc);
+    manifest << "InputTape: " << input_tape << "\nInputSize: " << input_size
+             << "\nOutputTape: " << output_tape << "\nCellType: " << cell_type
+             << "\nOrder: " << order << "\nTempTapeExtension: " << temp_tape_extension
+             << "\nInputCells: " << input_cells << "\nRunsComplete: " << (runs_complete ? 1 : 0)
+             << "\nRunSizes: ";
+    writeNumberList(manifest, run_sizes);
+    manifest << "\nRunsSorted: ";
+    writeNumberList(manifest, runs_sorted);
+    manifest << "\nMergeOutputCells: " << merge_output_cells
+             << "\nMergeOutputBytes: " << merge_output_bytes << "\nMergeConsumed: ";
+    writeNumberList(manifest, merge_consumed);
+    manifest << "\n";
+
+    manifest.flush();
+    if (!manifest) {
+      throw std::runtime_error("не удалось записать манифест контрольной точки '" +
+                               new_manifest_path.string() + "'.");
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(new_manifest_path, t_manifest_path, ec);
+  if (ec) {
+    throw std::runtime_error("не удалось записать манифест контрольной точки '" +
+                             t_manifest_path.string() + "': " + ec.message() + ".");
+  }
+}
+
+bool SortCheckpoint::isSameSort(const SortCheckpoint& t_other) const noexcept {
+  return input_tape == t_other.input_tape && input_size == t_other.input_size &&
+         output_tape == t_other.output_tape && cell_type == t_other.cell_type &&
+         order == t_other.order && temp_tape_extension == t_other.temp_tape_extension;
+}
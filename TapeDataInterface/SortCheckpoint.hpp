@@ -0,0 +1,83 @@
+#ifndef SORT_CHECKPOINT_HPP
+#define SORT_CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/*
+ * Структура SortCheckpoint
+ *
+ * Контрольная точка сортировки: состояние сортировщика, которого достаточно,
+ * чтобы продолжить прерванную сортировку, не считывая входную ленту заново
+ * (см. TapeDevConfig::checkpoint_interval). Контрольная точка хранится в
+ * файле описания (манифесте) в каталоге временных лент var/tmp рядом с
+ * самими временными лентами.
+ *
+ * Манифест - текстовый файл из строк вида "Ключ: значение", как и файл
+ * конфигурации устройства. Манифест заменяется атомарно: новая контрольная
+ * точка записывается во временный файл, который затем переименовывается, поэтому
+ * после сбоя в манифесте остаётся последняя полностью записанная контрольная
+ * точка.
+ */
+struct SortCheckpoint final {
+  /// Создаёт пустую контрольную точку, списки которой выделяются из
+  /// переданного источника памяти.
+  explicit SortCheckpoint(std::pmr::memory_resource* = std::pmr::get_default_resource());
+
+  /// Возвращает путь к манифесту в переданном каталоге данных программы.
+  static std::filesystem::path manifestPath(const std::filesystem::path&);
+
+  /// Загружает контрольную точку из манифеста по переданному пути.
+  /// Возвращает false, если манифеста нет. Если манифест повреждён,
+  /// выбрасывает std::runtime_error.
+  bool load(const std::filesystem::path&);
+
+  /// Атомарно записывает контрольную точку в манифест по переданному пути.
+  /// Если записать манифест не удалось, выбрасывает std::runtime_error.
+  void save(const std::filesystem::path&) const;
+
+  /// Показывает, что контрольная точка относится к той же сортировке, что и
+  /// переданная: совпадают входная и выходная ленты, размер файла входной
+  /// ленты, тип ячеек, порядок сортировки и формат временных лент.
+  bool isSameSort(const SortCheckpoint&) const noexcept;
+
+  /// Путь к файлу входной ленты.
+  std::string input_tape;
+  /// Размер файла входной ленты в байтах.
+  std::uintmax_t input_size;
+  /// Путь к файлу выходной ленты.
+  std::string output_tape;
+  /// Имя типа ячеек лент (см. TapeCellCodec::kName).
+  std::string cell_type;
+  /// Имя компаратора, задающего порядок сортировки.
+  std::string order;
+  /// Расширение файлов временных лент.
+  std::string temp_tape_extension;
+
+  /// Количество ячеек входной ленты, вошедших в завершённые отрезки.
+  /// Завершённые отрезки составлены из начала входной ленты, поэтому
+  /// формирование отрезков продолжается с этой ячейки.
+  size_t input_cells;
+  /// Показывает, что все отрезки сформированы.
+  bool runs_complete;
+  /// Длины завершённых отрезков. Отрезок с индексом i записан на временную
+  /// ленту с тем же индексом.
+  std::pmr::vector<size_t> run_sizes;
+  /// Показывает для каждого отрезка, что он уже отсортирован.
+  std::pmr::vector<bool> runs_sorted;
+
+  /// Количество ячеек, записанных на выходную ленту при слиянии.
+  size_t merge_output_cells;
+  /// Размер файла выходной ленты в байтах после записи merge_output_cells
+  /// ячеек.
+  std::uintmax_t merge_output_bytes;
+  /// Количество ячеек каждой временной ленты, записанных на выходную ленту
+  /// при слиянии.
+  std::pmr::vector<size_t> merge_consumed;
+};
+
+#endif  // SORT_CHECKPOINT_HPP
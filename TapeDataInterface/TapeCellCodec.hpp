@@ -0,0 +1,332 @@
+#ifndef TAPE_CELL_CODEC_HPP
+#define TAPE_CELL_CODEC_HPP
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "TapeDevExceptions.hpp"
+#include "TextCellParser.hpp"
+
+/*
+ * Структура TapeRecord
+ *
+ * Запись фиксированного размера: 64-битный ключ и полезная нагрузка. Записи
+ * упорядочиваются только по ключу, полезная нагрузка переносится вместе с
+ * ключом. В текстовом формате запись имеет вид "ключ:нагрузка", например
+ * "-5:42".
+ */
+struct TapeRecord final {
+  std::int64_t key = 0;
+  std::uint64_t payload = 0;
+};
+
+inline bool operator<(const TapeRecord& t_lhs, const TapeRecord& t_rhs) noexcept {
+  return t_lhs.key < t_rhs.key;
+}
+
+inline bool operator>(const TapeRecord& t_lhs, const TapeRecord& t_rhs) noexcept {
+  return t_rhs < t_lhs;
+}
+
+inline bool operator==(const TapeRecord& t_lhs, const TapeRecord& t_rhs) noexcept {
+  return t_lhs.key == t_rhs.key && t_lhs.payload == t_rhs.payload;
+}
+
+inline bool operator!=(const TapeRecord& t_lhs, const TapeRecord& t_rhs) noexcept {
+  return !(t_lhs == t_rhs);
+}
+
+/*
+ * Шаблон TapeCellCodec
+ *
+ * Кодек ячейки ленты: определяет для типа значения ячейки текстовое и
+ * бинарное представления (см. doc/tape_file_format.md) и ключ поразрядной
+ * сортировки. Кодек выбирается во время компиляции по типу ячейки, поэтому
+ * устройства и сортировщик, параметризованные типом ячейки, не платят за
+ * обобщённость: для 'int' блоки текстовой ленты разбираются векторной
+ * реализацией parseTextCells().
+ *
+ * Кодеки определены для std::int32_t, std::int64_t, std::uint64_t и
+ * TapeRecord. Каждый кодек содержит:
+ *   kName            - имя типа ячейки (совпадает со значением параметра
+ *                      CellType в файле конфигурации устройства);
+ *   kBinaryMagic     - сигнатура бинарного файла ленты;
+ *   kBinarySize      - размер ячейки в бинарном формате;
+ *   kMaxTextSize     - максимальная длина значения в текстовом формате;
+ *   isValueChar()    - может ли символ входить в значение;
+ *   format()         - записывает значение в текстовом формате;
+ *   parse()          - разбирает значение в текстовом формате;
+ *   parseBlock()     - разбирает блок текстовой ленты (см. parseTextCells());
+ *   encode()/decode()- преобразуют значение в бинарный формат и обратно;
+ *   radixKey()       - беззнаковый ключ, порядок которого совпадает с
+ *                      порядком значений по возрастанию.
+ */
+template <typename T>
+struct TapeCellCodec;
+
+/// Разбирает ячейки текстовой ленты с помощью переданного кодека. Аргументы и
+/// результат такие же, как у parseTextCells(), но значения разбираются
+/// посимвольно.
+template <typename Codec, typename T>
+TextCellsParseResult parseTextCellsWithCodec(const char* t_data, size_t t_size, T* t_buf,
+                                             size_t t_count, bool t_last_chunk,
+                                             size_t* t_cell_offsets) {
+  TextCellsParseResult res;
+  size_t pos = 0;
+
+  while (res.num_values < t_count) {
+    while (pos < t_size && std::isspace(static_cast<unsigned char>(t_data[pos]))) {
+      ++pos;
+    }
+    if (pos == t_size) {
+      break;
+    }
+
+    const size_t value_start = pos;
+    while (pos < t_size && Codec::isValueChar(t_data[pos])) {
+      ++pos;
+    }
+    if (pos < t_size && !std::isspace(static_cast<unsigned char>(t_data[pos]))) {
+      throw BadTapeException("Недопустимый символ на ленте: '" + std::string(1, t_data[pos]) +
+                             "'.");
+    }
+
+    // Незавершённое значение в конце не последнего блока не считывается.
+    if (pos == t_size && !t_last_chunk) {
+      res.num_chars = value_start;
+      return res;
+    }
+
+    if (t_cell_offsets != nullptr) {
+      t_cell_offsets[res.num_values] = value_start;
+    }
+    t_buf[res.num_values++] = Codec::parse(t_data + value_start, t_data + pos);
+  }
+
+  res.num_chars = pos;
+  return res;
+}
+
+/*
+ * Шаблон IntegerTapeCellCodec
+ *
+ * Общая часть кодеков целочисленных ячеек. Значение в текстовом формате -
+ * десятичная запись, перед которой у знаковых типов может стоять знак минус,
+ * в бинарном - целое в порядке little-endian.
+ */
+template <typename T>
+struct IntegerTapeCellCodec {
+  static_assert(std::is_integral_v<T>, "IntegerTapeCellCodec требует целочисленный тип.");
+
+  using RadixKey = std::make_unsigned_t<T>;
+
+  static constexpr size_t kBinarySize = sizeof(T);
+
+  /// Знак минус и цифры.
+  static constexpr size_t kMaxTextSize = std::numeric_limits<T>::digits10 + 2;
+
+  static bool isValueChar(char t_ch) noexcept {
+    return static_cast<unsigned char>(t_ch - '0') < 10 || (std::is_signed_v<T> && t_ch == '-');
+  }
+
+  /// Записывает значение, начиная с переданного указателя, и возвращает
+  /// указатель на символ после него. Требуется не больше kMaxTextSize
+  /// символов.
+  static char* format(char* t_first, T t_value) noexcept {
+    return std::to_chars(t_first, t_first + kMaxTextSize, t_value).ptr;
+  }
+
+  /// Разбирает значение [t_begin, t_end). Если значение недопустимо или
+  /// выходит за границы типа, выбрасывает BadTapeException.
+  static T parse(const char* t_begin, const char* t_end) {
+    T value = 0;
+    const std::from_chars_result res = std::from_chars(t_begin, t_end, value);
+    if (res.ec == std::errc::result_out_of_range) {
+      throw BadTapeException(
+          "Не удалось выполнить преобразование значения с ленты в целое цисло: значение выходит "
+          "за границы типа '" +
+          std::string(TapeCellCodec<T>::kName) + "'.");
+    }
+    if (res.ec != std::errc() || res.ptr != t_end) {
+      throw BadTapeException("Недопустимое значение на ленте: '" + std::string(t_begin, t_end) +
+                             "'.");
+    }
+    return value;
+  }
+
+  static TextCellsParseResult parseBlock(const char* t_data, size_t t_size, T* t_buf,
+                                         size_t t_count, bool t_last_chunk,
+                                         size_t* t_cell_offsets) {
+    return parseTextCellsWithCodec<TapeCellCodec<T>>(t_data, t_size, t_buf, t_count,
+                                                     t_last_chunk, t_cell_offsets);
+  }
+
+  static void encode(T t_value, unsigned char* t_bytes) noexcept {
+    const auto value = static_cast<RadixKey>(t_value);
+    for (size_t i = 0; i < kBinarySize; ++i) {
+      t_bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+  }
+
+  static T decode(const unsigned char* t_bytes) noexcept {
+    RadixKey value = 0;
+    for (size_t i = 0; i < kBinarySize; ++i) {
+      value |= static_cast<RadixKey>(t_bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+  }
+
+  /// Инвертирование знакового бита переводит порядок знакового типа в
+  /// порядок беззнаковых чисел.
+  static RadixKey radixKey(T t_value) noexcept {
+    if constexpr (std::is_signed_v<T>) {
+      return static_cast<RadixKey>(t_value) ^
+             (RadixKey(1) << (std::numeric_limits<RadixKey>::digits - 1));
+    } else {
+      return t_value;
+    }
+  }
+};
+
+template <>
+struct TapeCellCodec<std::int32_t> : IntegerTapeCellCodec<std::int32_t> {
+  static constexpr const char* kName = "int32";
+
+  static constexpr char kBinaryMagic[8] = {'T', 'A', 'P', 'E', 'B', 'I', 'N', '1'};
+
+  /// Блоки разбираются векторной реализацией.
+  static TextCellsParseResult parseBlock(const char* t_data, size_t t_size, std::int32_t* t_buf,
+                                         size_t t_count, bool t_last_chunk,
+                                         size_t* t_cell_offsets) {
+    return parseTextCells(t_data, t_size, t_buf, t_count, t_last_chunk, t_cell_offsets);
+  }
+};
+
+template <>
+struct TapeCellCodec<std::int64_t> : IntegerTapeCellCodec<std::int64_t> {
+  static constexpr const char* kName = "int64";
+
+  static constexpr char kBinaryMagic[8] = {'T', 'A', 'P', 'E', 'B', 'I', '6', '4'};
+};
+
+template <>
+struct TapeCellCodec<std::uint64_t> : IntegerTapeCellCodec<std::uint64_t> {
+  static constexpr const char* kName = "uint64";
+
+  static constexpr char kBinaryMagic[8] = {'T', 'A', 'P', 'E', 'B', 'U', '6', '4'};
+};
+
+template <>
+struct TapeCellCodec<TapeRecord> {
+  using KeyCodec = TapeCellCodec<std::int64_t>;
+  using PayloadCodec = TapeCellCodec<std::uint64_t>;
+  using RadixKey = KeyCodec::RadixKey;
+
+  static constexpr const char* kName = "record";
+
+  static constexpr char kBinaryMagic[8] = {'T', 'A', 'P', 'E', 'B', 'R', 'E', 'C'};
+
+  static constexpr size_t kBinarySize = KeyCodec::kBinarySize + PayloadCodec::kBinarySize;
+
+  /// Ключ, разделитель и полезная нагрузка.
+  static constexpr size_t kMaxTextSize = KeyCodec::kMaxTextSize + 1 + PayloadCodec::kMaxTextSize;
+
+  /// Разделитель ключа и полезной нагрузки в текстовом формате.
+  static constexpr char kSeparator = ':';
+
+  static bool isValueChar(char t_ch) noexcept {
+    return KeyCodec::isValueChar(t_ch) || t_ch == kSeparator;
+  }
+
+  static char* format(char* t_first, const TapeRecord& t_value) noexcept {
+    char* last = KeyCodec::format(t_first, t_value.key);
+    *last++ = kSeparator;
+    return PayloadCodec::format(last, t_value.payload);
+  }
+
+  static TapeRecord parse(const char* t_begin, const char* t_end) {
+    const char* separator = t_begin;
+    while (separator != t_end && *separator != kSeparator) {
+      ++separator;
+    }
+    if (separator == t_end) {
+      throw BadTapeException("Недопустимое значение на ленте: '" + std::string(t_begin, t_end) +
+                             "'. Запись должна иметь вид 'ключ:нагрузка'.");
+    }
+    return TapeRecord{KeyCodec::parse(t_begin, separator),
+                      PayloadCodec::parse(separator + 1, t_end)};
+  }
+
+  static TextCellsParseResult parseBlock(const char* t_data, size_t t_size, TapeRecord* t_buf,
+                                         size_t t_count, bool t_last_chunk,
+                                         size_t* t_cell_offsets) {
+    return parseTextCellsWithCodec<TapeCellCodec<TapeRecord>>(t_data, t_size, t_buf, t_count,
+                                                              t_last_chunk, t_cell_offsets);
+  }
+
+  static void encode(const TapeRecord& t_value, unsigned char* t_bytes) noexcept {
+    KeyCodec::encode(t_value.key, t_bytes);
+    PayloadCodec::encode(t_value.payload, t_bytes + KeyCodec::kBinarySize);
+  }
+
+  static TapeRecord decode(const unsigned char* t_bytes) noexcept {
+    return TapeRecord{KeyCodec::decode(t_bytes),
+                      PayloadCodec::decode(t_bytes + KeyCodec::kBinarySize)};
+  }
+
+  /// Записи упорядочиваются только по ключу.
+  static RadixKey radixKey(const TapeRecord& t_value) noexcept {
+    return KeyCodec::radixKey(t_value.key);
+  }
+};
+
+/// Перечисление, определяющее тип ячеек лент, с которыми работают устройства
+/// и сортировщик.
+enum class TapeCellType { Int32, Int64, UInt64, Record };
+
+/// Вызывает переданный функциональный объект со значением по умолчанию типа
+/// ячеек, соответствующего переданному TapeCellType, и возвращает результат
+/// вызова. Позволяет выбрать инстанцирование шаблонов устройств и
+/// сортировщика по типу ячеек, заданному во время выполнения.
+template <typename Visitor>
+decltype(auto) visitTapeCellType(TapeCellType t_cell_type, Visitor&& t_visitor) {
+  switch (t_cell_type) {
+    case TapeCellType::Int64:
+      return t_visitor(std::int64_t());
+    case TapeCellType::UInt64:
+      return t_visitor(std::uint64_t());
+    case TapeCellType::Record:
+      return t_visitor(TapeRecord());
+    case TapeCellType::Int32:
+    default:
+      return t_visitor(std::int32_t());
+  }
+}
+
+/// Возвращает имя переданного типа ячеек (см. TapeCellCodec<T>::kName).
+inline std::string tapeCellTypeName(TapeCellType t_cell_type) {
+  return visitTapeCellType(t_cell_type, [](auto t_cell) {
+    return std::string(TapeCellCodec<decltype(t_cell)>::kName);
+  });
+}
+
+/// Возвращает тип ячеек с переданным именем. Если тип с таким именем не
+/// определён, выбрасывает std::invalid_argument.
+inline TapeCellType tapeCellTypeFromName(const std::string& t_name) {
+  for (TapeCellType cell_type : {TapeCellType::Int32, TapeCellType::Int64, TapeCellType::UInt64,
+                                 TapeCellType::Record}) {
+    if (tapeCellTypeName(cell_type) == t_name) {
+      return cell_type;
+    }
+  }
+  throw std::invalid_argument(t_name);
+}
+
+#endif  // TAPE_CELL_CODEC_HPP
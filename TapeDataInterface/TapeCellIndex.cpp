@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include "TapeCellIndex.hpp"
+
+namespace {
+
+/// Количество полей заголовка файла индекса после сигнатуры: шаг индекса,
+/// размер файла ленты, время последнего изменения файла ленты, количество
+/// ячеек на ленте и количество смещений в индексе.
+constexpr size_t kNumHeaderFields = 5;
+
+/// Кодирует 64-битное значение в 8 байт в порядке little-endian.
+void encodeU64(std::uint64_t t_value, unsigned char* t_bytes) noexcept {
+  for (size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+    t_bytes[i] = static_cast<unsigned char>(t_value >> (8 * i));
+  }
+}
+
+/// Декодирует 64-битное значение из 8 байт в порядке little-endian.
+std::uint64_t decodeU64(const unsigned char* t_bytes) noexcept {
+  std::uint64_t value = 0;
+  for (size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+    value |= static_cast<std::uint64_t>(t_bytes[i]) << (8 * i);
+  }
+  return value;
+}
+
+/// Определяет размер и время последнего изменения файла ленты, по которым
+/// проверяется актуальность файла индекса. Возвращает false, если их не
+/// удалось определить.
+bool getTapeFileStamp(const std::filesystem::path& t_tape_file_path, std::uint64_t& t_size,
+                      std::uint64_t& t_mtime) noexcept {
+  std::error_code ec;
+  const std::uintmax_t size = std::filesystem::file_size(t_tape_file_path, ec);
+  if (ec) {
+    return false;
+  }
+  const auto mtime = std::filesystem::last_write_time(t_tape_file_path, ec);
+  if (ec) {
+    return false;
+  }
+  t_size = static_cast<std::uint64_t>(size);
+  t_mtime = static_cast<std::uint64_t>(mtime.time_since_epoch().count());
+  return true;
+}
+
+}  // namespace
+
+TapeCellIndex::TapeCellIndex(size_t t_stride) noexcept
+    : m_stride(t_stride), m_complete_flag(false), m_num_cells(0) {}
+
+bool TapeCellIndex::isEnabled() const noexcept {
+  return m_stride > 0;
+}
+
+size_t TapeCellIndex::getStride() const noexcept {
+  return m_stride;
+}
+
+void TapeCellIndex::recordCell(size_t t_cell, std::streamoff t_offset) {
+  if (m_stride == 0 || m_complete_flag || t_cell % m_stride != 0 ||
+      t_cell / m_stride != m_offsets.size()) {
+    return;
+  }
+  m_offsets.push_back(t_offset);
+}
+
+void TapeCellIndex::markComplete(size_t t_num_cells) noexcept {
+  if (m_stride == 0 || m_complete_flag) {
+    return;
+  }
+  // Ячейка 0 индексируется всегда, даже на пустой ленте.
+  const size_t num_checkpoints = t_num_cells > 0 ? (t_num_cells - 1) / m_stride + 1 : 1;
+  // Позиция за последней ячейкой (на пробельных символах в конце ленты)
+  // могла попасть в индекс, но ячейкой не является.
+  if (m_offsets.size() > num_checkpoints) {
+    m_offsets.resize(num_checkpoints);
+  }
+  if (m_offsets.size() == num_checkpoints) {
+    m_complete_flag = true;
+    m_num_cells = t_num_cells;
+  }
+}
+
+bool TapeCellIndex::isComplete() const noexcept {
+  return m_complete_flag;
+}
+
+size_t TapeCellIndex::getNumCells() const noexcept {
+  return m_num_cells;
+}
+
+bool TapeCellIndex::findCheckpoint(size_t t_cell, size_t& t_checkpoint_cell,
+                                   std::streamoff& t_offset) const noexcept {
+  if (m_offsets.empty()) {
+    return false;
+  }
+  const size_t i = std::min(t_cell / m_stride, m_offsets.size() - 1);
+  t_checkpoint_cell = i * m_stride;
+  t_offset = m_offsets[i];
+  return true;
+}
+
+void TapeCellIndex::clear() noexcept {
+  m_offsets.clear();
+  m_complete_flag = false;
+  m_num_cells = 0;
+}
+
+bool TapeCellIndex::load(const std::filesystem::path& t_tape_file_path) noexcept {
+  clear();
+  if (m_stride == 0) {
+    return false;
+  }
+
+  std::uint64_t tape_size = 0;
+  std::uint64_t tape_mtime = 0;
+  if (!getTapeFileStamp(t_tape_file_path, tape_size, tape_mtime)) {
+    return false;
+  }
+
+  try {
+    std::ifstream index_file(indexFilePath(t_tape_file_path), std::ios::in | std::ios::binary);
+    if (!index_file.is_open()) {
+      return false;
+    }
+
+    unsigned char header[sizeof(kMagic) + kNumHeaderFields * sizeof(std::uint64_t)];
+    if (!index_file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+      return false;
+    }
+
+    const unsigned char* fields = header + sizeof(kMagic);
+    const std::uint64_t stride = decodeU64(fields);
+    const std::uint64_t size = decodeU64(fields + 8);
+    const std::uint64_t mtime = decodeU64(fields + 16);
+    const std::uint64_t num_cells = decodeU64(fields + 24);
+    const std::uint64_t num_offsets = decodeU64(fields + 32);
+
+    // Индекс, построенный с другим шагом или для другого содержимого ленты,
+    // не используется.
+    if (stride != m_stride || size != tape_size || mtime != tape_mtime ||
+        num_offsets != (num_cells > 0 ? (num_cells - 1) / m_stride + 1 : 1)) {
+      return false;
+    }
+
+    std::vector<unsigned char> bytes(num_offsets * sizeof(std::uint64_t));
+    if (!index_file.read(reinterpret_cast<char*>(bytes.data()),
+                         static_cast<std::streamsize>(bytes.size()))) {
+      return false;
+    }
+
+    m_offsets.resize(num_offsets);
+    for (size_t i = 0; i < num_offsets; ++i) {
+      m_offsets[i] = static_cast<std::streamoff>(decodeU64(bytes.data() + i * 8));
+    }
+    m_complete_flag = true;
+    m_num_cells = num_cells;
+    return true;
+  } catch (const std::exception& e) {
+    clear();
+    return false;
+  }
+}
+
+bool TapeCellIndex::save(const std::filesystem::path& t_tape_file_path) const noexcept {
+  if (!m_complete_flag) {
+    return false;
+  }
+
+  std::uint64_t tape_size = 0;
+  std::uint64_t tape_mtime = 0;
+  if (!getTapeFileStamp(t_tape_file_path, tape_size, tape_mtime)) {
+    return false;
+  }
+
+  try {
+    std::vector<unsigned char> bytes(sizeof(kMagic) +
+                                     (kNumHeaderFields + m_offsets.size()) * sizeof(std::uint64_t));
+    std::memcpy(bytes.data(), kMagic, sizeof(kMagic));
+    unsigned char* fields = bytes.data() + sizeof(kMagic);
+    encodeU64(m_stride, fields);
+    encodeU64(tape_size, fields + 8);
+    encodeU64(tape_mtime, fields + 16);
+    encodeU64(m_num_cells, fields + 24);
+    encodeU64(m_offsets.size(), fields + 32);
+    for (size_t i = 0; i < m_offsets.size(); ++i) {
+      encodeU64(static_cast<std::uint64_t>(m_offsets[i]),
+                fields + (kNumHeaderFields + i) * sizeof(std::uint64_t));
+    }
+
+    std::ofstream index_file(indexFilePath(t_tape_file_path),
+                             std::ios::out | std::ios::trunc | std::ios::binary);
+    index_file.write(reinterpret_cast<const char*>(bytes.data()),
+                     static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(index_file);
+  } catch (const std::exception& e) {
+    return false;
+  }
+}
+
+std::filesystem::path TapeCellIndex::indexFilePath(const std::filesystem::path& t_tape_file_path) {
+  std::filesystem::path index_file_path = t_tape_file_path;
+  index_file_path += kTapeCellIndexFileExtension;
+  return index_file_path;
+}
@@ -0,0 +1,91 @@
+#ifndef TAPE_CELL_INDEX_HPP
+#define TAPE_CELL_INDEX_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <ios>
+#include <vector>
+
+/*
+ * Класс TapeCellIndex
+ *
+ * Индекс смещений ячеек ленты в текстовом формате: хранит смещение в файле
+ * ленты каждой ячейки, индекс которой кратен шагу индекса. Индекс строится
+ * при первом последовательном проходе по ленте, а после прохода до конца
+ * ленты может быть сохранён в файл рядом с файлом ленты (см.
+ * doc/tape_file_format.md), чтобы следующие устройства, которые читают ту же
+ * ленту, могли сразу переходить к нужной ячейке.
+ *
+ * Смещение ячейки - позиция в файле ленты, с которой операции устройства
+ * начинаются, когда головка находится на этой ячейке.
+ */
+class TapeCellIndex final {
+ public:
+  /// Создаёт пустой индекс с переданным шагом. Шаг 0 отключает индекс.
+  explicit TapeCellIndex(size_t) noexcept;
+
+  /// Показывает, что индекс включён (шаг больше нуля).
+  bool isEnabled() const noexcept;
+
+  /// Возвращает шаг индекса.
+  size_t getStride() const noexcept;
+
+  /// Учитывает смещение ячейки, до которой дошла головка. Смещение
+  /// запоминается, только если индекс ячейки кратен шагу, а все предыдущие
+  /// кратные шагу ячейки уже проиндексированы.
+  void recordCell(size_t, std::streamoff);
+
+  /// Отмечает, что последовательный проход дошёл до конца ленты, на которой
+  /// переданное количество ячеек. Индекс становится полным, если в нём
+  /// учтены все кратные шагу ячейки ленты.
+  void markComplete(size_t) noexcept;
+
+  /// Показывает, что в индексе учтены все кратные шагу ячейки ленты.
+  bool isComplete() const noexcept;
+
+  /// Возвращает количество ячеек на ленте. Известно только для полного
+  /// индекса.
+  size_t getNumCells() const noexcept;
+
+  /// Находит ближайшую проиндексированную ячейку, индекс которой не больше
+  /// переданного. Записывает её индекс и смещение во второй и третий
+  /// аргументы. Возвращает false, если индекс пуст.
+  bool findCheckpoint(size_t, size_t&, std::streamoff&) const noexcept;
+
+  /// Очищает индекс.
+  void clear() noexcept;
+
+  /// Загружает полный индекс из файла индекса переданной ленты. Возвращает
+  /// false и оставляет индекс пустым, если файла индекса нет, он повреждён,
+  /// построен с другим шагом или лента изменилась после его построения.
+  bool load(const std::filesystem::path&) noexcept;
+
+  /// Сохраняет полный индекс в файл индекса переданной ленты. Возвращает
+  /// false, если индекс неполон или файл не удалось записать.
+  bool save(const std::filesystem::path&) const noexcept;
+
+  /// Возвращает путь к файлу индекса ленты: к пути файла ленты добавляется
+  /// расширение kTapeCellIndexFileExtension.
+  static std::filesystem::path indexFilePath(const std::filesystem::path&);
+
+  /// Расширение файла индекса.
+  static constexpr const char* kTapeCellIndexFileExtension = ".idx";
+
+  /// Сигнатура в начале файла индекса.
+  static constexpr char kMagic[8] = {'T', 'A', 'P', 'E', 'I', 'D', 'X', '1'};
+
+ private:
+  /// Шаг индекса.
+  size_t m_stride;
+
+  /// Смещения ячеек с индексами 0, m_stride, 2 * m_stride, ...
+  std::vector<std::streamoff> m_offsets;
+
+  /// Показывает, что индекс полон.
+  bool m_complete_flag;
+
+  /// Количество ячеек на ленте, если индекс полон.
+  size_t m_num_cells;
+};
+
+#endif  // TAPE_CELL_INDEX_HPP
@@ -1,15 +1,19 @@
-#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
-#include <thread>
+#include <vector>
 
 #include "TapeDev.hpp"
 #include "TapeDevConfig.hpp"
 #include "TapeDevExceptions.hpp"
 
-TapeDev::TapeDev(const std::filesystem::path& t_tape_file_path, const TapeDevConfig& t_dev_config,
-                 const TapeDevOperationMode t_mode) noexcept
+template <typename T>
+BasicTapeDev<T>::BasicTapeDev(const std::filesystem::path& t_tape_file_path,
+                              const TapeDevConfig& t_dev_config,
+                              const TapeDevOperationMode t_mode) noexcept
     : m_tape_file_path(t_tape_file_path),
       m_dev_config(t_dev_config),
       m_operation_mode(t_mode),
@@ -18,7 +22,8 @@ TapeDev::TapeDev(const std::filesystem::path& t_tape_file_path, const TapeDevCon
       m_head_pos(0),
       m_start_of_tape_flag(true),
       m_end_of_tape_flag(false),
-      m_first_write_flag(false) {
+      m_first_write_flag(false),
+      m_cell_index(0) {
   // Открываем файл устройства прямо в конструкторе. Не делаем
   // дополнительных проверок на успешность операции, потому что на стадии
   // проверки и обработки аргументов командной строки гарантируем валидный
@@ -33,15 +38,49 @@ TapeDev::TapeDev(const std::filesystem::path& t_tape_file_path, const TapeDevCon
     m_tape_file.open(m_tape_file_path, std::ios::out | std::ios::app);
   }
 
+  // При дописывании в непустую ленту первое значение отделяется пробелом от
+  // уже записанных.
   if (m_operation_mode == TapeDevOperationMode::Write ||
-      m_operation_mode == TapeDevOperationMode::Append) {
+      (m_operation_mode == TapeDevOperationMode::Append && m_tape_file.tellp() == 0)) {
     m_first_write_flag = true;
   }
 
-  m_mem_buf = new int[m_dev_config.mem_buf_size];
+  m_mem_buf = new T[m_dev_config.mem_buf_size];
+
+  loadCellIndex();
+}
+
+template <typename T>
+void BasicTapeDev<T>::loadCellIndex() {
+  if (m_operation_mode != TapeDevOperationMode::Read) {
+    m_cell_index = TapeCellIndex(0);
+    std::error_code ec;
+    std::filesystem::remove(TapeCellIndex::indexFilePath(m_tape_file_path), ec);
+    return;
+  }
+
+  m_cell_index = TapeCellIndex(m_dev_config.cell_index_stride);
+  if (m_cell_index.isEnabled() && !m_cell_index.load(m_tape_file_path)) {
+    // Индекс будет построен при первом последовательном проходе по ленте.
+    m_cell_index.recordCell(0, 0);
+  }
+}
+
+template <typename T>
+void BasicTapeDev<T>::completeCellIndex(size_t t_num_cells) noexcept {
+  if (!m_cell_index.isEnabled() || m_cell_index.isComplete()) {
+    return;
+  }
+  m_cell_index.markComplete(t_num_cells);
+  if (m_cell_index.isComplete()) {
+    // Ошибка сохранения не мешает работе устройства: индекс будет построен
+    // заново следующим устройством.
+    m_cell_index.save(m_tape_file_path);
+  }
 }
 
-void TapeDev::doOneStepBackOnTape() noexcept {
+template <typename T>
+void BasicTapeDev<T>::doOneStepBackOnTape() noexcept {
   char ch;
   bool f = false;
 
@@ -60,11 +99,11 @@ void TapeDev::doOneStepBackOnTape() noexcept {
     if (!f && std::isspace(ch)) {
       continue;
     }
-    if (!f && std::isdigit(ch)) {
+    if (!f && Codec::isValueChar(ch)) {
       f = true;
       continue;
     }
-    if (f && std::isdigit(ch)) {
+    if (f && Codec::isValueChar(ch)) {
       continue;
     }
     if (f && std::isspace(ch)) {
@@ -76,11 +115,12 @@ void TapeDev::doOneStepBackOnTape() noexcept {
   }
 }
 
-int TapeDev::read() {
+template <typename T>
+T BasicTapeDev<T>::read() {
   if (m_operation_mode == TapeDevOperationMode::Read ||
       m_operation_mode == TapeDevOperationMode::ReadWrite) {
     if (!m_end_of_tape_flag) {
-      int res = 0;
+      T res{};
 
       std::string cell;
       char ch;
@@ -104,7 +144,7 @@ int TapeDev::read() {
 
           continue;
         }
-        if (std::isdigit(ch)) {
+        if (Codec::isValueChar(ch)) {
           cell += ch;
         } else {
           throw BadTapeException("Недопустимый символ на ленте: '" + std::string(1, ch) + "'.");
@@ -114,6 +154,7 @@ int TapeDev::read() {
       // Отмечаем в состоянии устройства достижение конца ленты.
       if (m_tape_file.eof()) {
         m_end_of_tape_flag = true;
+        completeCellIndex(m_head_pos + 1);
       }
 
       // NOTE: оставлю этот блок с условием, потому что возможна ситуация,
@@ -121,13 +162,7 @@ int TapeDev::read() {
       // В этом случае код выше отработает корректно, но на данном этапе будет
       // получена пустая строка, что приведёт к ошибке преобразования.
       if (!cell.empty()) {
-        try {
-          m_mem_buf[m_mem_buf_index] = std::stoi(cell);
-        } catch (const std::exception& e) {
-          throw BadTapeException(
-              "Не удалось выполнить преобразование значения с ленты в целое цисло. Значение: " +
-              cell + ".");
-        }
+        m_mem_buf[m_mem_buf_index] = Codec::parse(cell.data(), cell.data() + cell.size());
         res = m_mem_buf[m_mem_buf_index];
         m_mem_buf_index = (m_mem_buf_index + 1) % m_dev_config.mem_buf_size;
       } else {
@@ -136,6 +171,9 @@ int TapeDev::read() {
             "лишние пробелы.");
       }
 
+      // Эмулируем время, необходимое устройству для выполнения чтения с ленты.
+      emulateTapeDevDelay(m_dev_config, m_dev_config.read_delay);
+
       // Возвращаем только что считанное в память значение как результат
       // операции чтения.
       return res;
@@ -148,108 +186,383 @@ int TapeDev::read() {
     throw InvalidOperationException(
         "Чтение невозможно. Устройство работает в режиме только запись.");
   }
-  // Эмулируем время, необходимое устройству для выполнения чтения с ленты.
-  std::this_thread::sleep_for(std::chrono::milliseconds(m_dev_config.read_delay));
 }
 
-void TapeDev::write(int t_value) {
+template <typename T>
+void BasicTapeDev<T>::write(T t_value) {
   if (m_operation_mode == TapeDevOperationMode::Write ||
       m_operation_mode == TapeDevOperationMode::Append) {
-    std::string val_str = std::to_string(t_value);
-    if (!m_first_write_flag) {
-      m_tape_file << " ";
-    } else {
-      m_first_write_flag = false;
-    }
-    m_tape_file << val_str;
-    m_tape_file << std::flush;
+    appendCellToWriteBuf(t_value);
   } else if (m_operation_mode == TapeDevOperationMode::ReadWrite) {
-    std::string target_value = std::to_string(t_value);
+    writeInPlace(t_value);
+  } else {
+    throw InvalidOperationException(
+        "Запись невозможна. Устройство работает в режиме только чтение.");
+  }
+  // Эмулируем время, необходимое устройству для выполнения записи на ленту.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.write_delay);
+}
 
-    std::string swap_tape_file_name = "swap_tape.txt";
-    std::string target_tape_file_name = m_tape_file_path.filename().string();
-    std::filesystem::path target_tape_file_dir = m_tape_file_path.parent_path();
-    std::filesystem::path swap_tape_file_path = target_tape_file_dir / swap_tape_file_name;
+template <typename T>
+std::string BasicTapeDev<T>::formatCell(T t_value) const {
+  char digits[Codec::kMaxTextSize];
+  const auto num_digits = static_cast<size_t>(Codec::format(digits, t_value) - digits);
+  std::string val_str;
+  if (num_digits < m_dev_config.text_cell_width) {
+    val_str.assign(m_dev_config.text_cell_width - num_digits, ' ');
+  }
+  val_str.append(digits, num_digits);
+  return val_str;
+}
 
-    // Запоминаем текущую позицию курсора в файле.
-    std::streamoff pos = std::streamoff(m_tape_file.tellp());
-    if (pos != 0) {
-      pos += 1;
-    }
+template <typename T>
+void BasicTapeDev<T>::appendCellToWriteBuf(T t_value) {
+  if (!m_first_write_flag) {
+    m_write_buf += ' ';
+  } else {
+    m_first_write_flag = false;
+  }
 
-    // Открываем файл "swap_tape.txt" для записи.
-    std::ofstream swap_tape_file(swap_tape_file_path, std::ios::out | std::ios::trunc);
+  char digits[Codec::kMaxTextSize];
+  const auto num_digits = static_cast<size_t>(Codec::format(digits, t_value) - digits);
+  if (num_digits < m_dev_config.text_cell_width) {
+    m_write_buf.append(m_dev_config.text_cell_width - num_digits, ' ');
+  }
+  m_write_buf.append(digits, num_digits);
 
-    char ch;
-    std::string cell;
+  if (m_write_buf.size() >= kWriteBufSize) {
+    flush();
+  }
+}
 
-    m_tape_file.seekp(0, std::ios::beg);
+template <typename T>
+void BasicTapeDev<T>::flush() {
+  if (m_write_buf.empty()) {
+    return;
+  }
 
-    while (true) {
-      cell.clear();
-      while (m_tape_file.get(ch)) {
-        if (std::isspace(ch)) {
-          if (!cell.empty()) {
-            break;
-          }
-          continue;
-        }
-        if (std::isdigit(ch)) {
-          cell += ch;
-        } else {
-          throw BadTapeException("Недопустимый символ на ленте: '" + std::string(1, ch) + "'.");
-        }
-      }
+  m_tape_file.write(m_write_buf.data(), static_cast<std::streamsize>(m_write_buf.size()));
+  m_tape_file.flush();
+  m_write_buf.clear();
 
-      if (!cell.empty()) {
-        try {
-          int res = std::stoi(cell);
+  if (!m_tape_file) {
+    throw BadTapeException("Не удалось выполнить запись в файл ленты '" +
+                           m_tape_file_path.string() + "'.");
+  }
+}
 
-          if (swap_tape_file.tellp() == pos) {
-            swap_tape_file << target_value;
-          } else {
-            swap_tape_file << res;
-          }
-          swap_tape_file << std::flush;
-        } catch (const std::exception& e) {
-          throw BadTapeException(
-              "Не удалось выполнить преобразование значения с ленты в целое цисло. Значение: " +
-              cell + ".");
-        }
-      } else {
-        throw BadTapeException(
-            "Не удалось считать значение с ленты. Возможно, в конце файла ленты присутствуют "
-            "лишние пробелы.");
+template <typename T>
+void BasicTapeDev<T>::writeInPlace(T t_value) {
+  // Сбрасываем возможный флаг конца файла, установленный предыдущим чтением.
+  m_tape_file.clear();
+
+  const std::streamoff pos = m_tape_file.tellg();
+
+  // Находим границы значения в текущей ячейке.
+  std::streamoff digits_start = -1;
+  std::streamoff digits_end = -1;
+  std::streamoff curr = pos;
+  char ch;
+
+  m_tape_file.seekg(pos, std::ios::beg);
+  while (m_tape_file.get(ch)) {
+    if (std::isspace(ch)) {
+      if (digits_start >= 0) {
+        digits_end = curr;
+        break;
+      }
+    } else if (Codec::isValueChar(ch)) {
+      if (digits_start < 0) {
+        digits_start = curr;
       }
+    } else {
+      throw BadTapeException("Недопустимый символ на ленте: '" + std::string(1, ch) + "'.");
+    }
+    curr += 1;
+  }
 
-      if (m_tape_file.eof()) {
+  // Проверяем, есть ли на ленте ячейки после текущей.
+  bool has_next_cell = false;
+  if (digits_end >= 0) {
+    while (m_tape_file.get(ch)) {
+      if (!std::isspace(ch)) {
+        has_next_cell = true;
         break;
-      } else {
-        swap_tape_file << " ";
       }
     }
+  } else if (digits_start >= 0) {
+    digits_end = curr;
+  }
 
-    m_tape_file.close();
+  m_tape_file.clear();
 
-    // Удаляем текущий файл ленты.
-    std::filesystem::remove(m_tape_file_path);
+  char digits[Codec::kMaxTextSize];
+  const auto num_digits = static_cast<size_t>(Codec::format(digits, t_value) - digits);
+  const std::string cell = formatCell(t_value);
 
-    // Переименовываем swap-файл в текущий файл ленты.
-    std::filesystem::rename(swap_tape_file_path, m_tape_file_path);
+  if (digits_start < 0) {
+    // Головка находится за последней ячейкой ленты, поэтому дописываем
+    // значение в конец ленты.
+    m_tape_file.seekp(0, std::ios::end);
+    const std::streamoff tape_end = m_tape_file.tellp();
+    if (tape_end != 0) {
+      m_tape_file << " ";
+    }
+    m_tape_file << cell << std::flush;
+    seekToCellStart(tape_end + (tape_end != 0 ? 1 : 0) + cell.size() - num_digits);
+    return;
+  }
 
-    // Открываем сформированный файл ленты.
-    m_tape_file.open(m_tape_file_path, std::ios::in | std::ios::out);
+  // Ячейка может занять пробелы перед своим значением, оставив один пробел
+  // после значения предыдущей ячейки.
+  std::streamoff region_start = digits_start;
+  while (region_start > 0) {
+    m_tape_file.seekg(region_start - 1, std::ios::beg);
+    m_tape_file.get(ch);
+    if (!std::isspace(ch)) {
+      break;
+    }
+    region_start -= 1;
+  }
+  if (region_start > 0) {
+    region_start += 1;
+  }
+
+  const auto region_size = static_cast<size_t>(digits_end - region_start);
+
+  if (!has_next_cell) {
+    // Последнюю ячейку можно записать на месте при любой длине значения:
+    // файл ленты дописывается или усекается после неё.
+    m_tape_file.seekp(region_start, std::ios::beg);
+    m_tape_file << cell << std::flush;
+    std::filesystem::resize_file(m_tape_file_path, region_start + cell.size());
+    seekToCellStart(region_start + cell.size() - num_digits);
+  } else if (cell.size() == region_size ||
+             (m_dev_config.text_cell_width > 0 && cell.size() < region_size)) {
+    // Значение помещается в ячейку: выравниваем его по правому краю ячейки и
+    // изменяем байты файла на месте.
+    m_tape_file.seekp(region_start, std::ios::beg);
+    m_tape_file << std::string(region_size - cell.size(), ' ') << cell << std::flush;
+    seekToCellStart(digits_end - num_digits);
+  } else {
+    // Значение не помещается в ячейку, поэтому перезаписываем файл ленты.
+    rewriteTapeFileRegion(region_start, digits_end, cell);
+    seekToCellStart(region_start + cell.size() - num_digits);
+  }
+}
+
+template <typename T>
+void BasicTapeDev<T>::seekToCellStart(std::streamoff t_digits_start) {
+  // Поддерживаем состояние, при котором любая операция начинается на
+  // пробельном символе непосредственно перед целевым значением.
+  const std::streamoff pos = t_digits_start > 0 ? t_digits_start - 1 : 0;
+  m_tape_file.seekg(pos, std::ios::beg);
+  m_tape_file.seekp(pos, std::ios::beg);
+}
+
+template <typename T>
+void BasicTapeDev<T>::rewriteTapeFileRegion(std::streamoff t_region_start,
+                                            std::streamoff t_region_end,
+                                            const std::string& t_cell) {
+  std::string swap_tape_file_name = "swap_tape.txt";
+  std::filesystem::path target_tape_file_dir = m_tape_file_path.parent_path();
+  std::filesystem::path swap_tape_file_path = target_tape_file_dir / swap_tape_file_name;
+
+  m_tape_file.close();
+
+  {
+    std::ifstream tape_file(m_tape_file_path, std::ios::in | std::ios::binary);
+    std::ofstream swap_tape_file(swap_tape_file_path,
+                                 std::ios::out | std::ios::trunc | std::ios::binary);
+
+    // Копируем содержимое ленты до ячейки, затем новое значение ячейки, затем
+    // содержимое ленты после ячейки.
+    std::vector<char> buf(64 * 1024);
+    std::streamoff num_left = t_region_start;
+    while (num_left > 0) {
+      const auto chunk = std::min<std::streamoff>(num_left, buf.size());
+      tape_file.read(buf.data(), chunk);
+      swap_tape_file.write(buf.data(), tape_file.gcount());
+      num_left -= chunk;
+    }
+
+    swap_tape_file << t_cell;
+
+    tape_file.seekg(t_region_end, std::ios::beg);
+    while (tape_file.read(buf.data(), buf.size()) || tape_file.gcount() > 0) {
+      swap_tape_file.write(buf.data(), tape_file.gcount());
+    }
+
+    if (!swap_tape_file) {
+      throw BadTapeException("Не удалось перезаписать файл ленты '" + m_tape_file_path.string() +
+                             "'.");
+    }
+  }
+
+  // Заменяем текущий файл ленты swap-файлом.
+  std::filesystem::rename(swap_tape_file_path, m_tape_file_path);
+
+  // Открываем сформированный файл ленты.
+  m_tape_file.open(m_tape_file_path, std::ios::in | std::ios::out);
+}
+
+template <typename T>
+size_t BasicTapeDev<T>::readBlock(T* t_buf, size_t t_count) {
+  if (m_operation_mode != TapeDevOperationMode::Read &&
+      m_operation_mode != TapeDevOperationMode::ReadWrite) {
+    throw InvalidOperationException(
+        "Чтение невозможно. Устройство работает в режиме только запись.");
+  }
+
+  if (t_count == 0 || m_end_of_tape_flag) {
+    return 0;
+  }
+
+  // Размер порции рассчитан на t_count значений наибольшей длины с
+  // разделителями, поэтому чтение небольшого блока не считывает лишнего.
+  // Если значения окажутся длиннее (например, с ведущими нулями), порции
+  // считываются повторно.
+  const size_t max_cell_chars =
+      std::max(Codec::kMaxTextSize, m_dev_config.text_cell_width) + 1;
+  size_t chunk_size =
+      std::min(kMaxReadChunkSize, std::min(t_count, kMaxReadChunkSize) * max_cell_chars);
+  const bool record_offsets = m_cell_index.isEnabled() && !m_cell_index.isComplete();
+  auto reserve_chunk = [&]() {
+    if (m_read_chunk.size() < chunk_size) {
+      m_read_chunk.resize(chunk_size);
+    }
+    if (record_offsets && m_read_cell_offsets.size() < chunk_size) {
+      m_read_cell_offsets.resize(chunk_size);
+    }
+  };
+  reserve_chunk();
+  char* chunk = m_read_chunk.data();
+  size_t* cell_offsets = record_offsets ? m_read_cell_offsets.data() : nullptr;
+  // Смещение в файле ленты первого символа, находящегося в начале chunk.
+  std::streamoff chunk_pos = m_tape_file.tellg();
+  // Количество символов в начале chunk, перенесённых из предыдущей порции:
+  // незавершённое значение, разорванное границей порции.
+  size_t num_carried_chars = 0;
+
+  size_t num_read_values = 0;
+  // Смещение пробельного символа, следующего за последним считанным
+  // значением, если блок заполнен до достижения конца файла ленты.
+  std::streamoff block_end = -1;
+
+  while (true) {
+    if (num_carried_chars == chunk_size) {
+      // Порция целиком занята незавершённым значением (например, с большим
+      // количеством ведущих нулей).
+      chunk_size *= 2;
+      reserve_chunk();
+      chunk = m_read_chunk.data();
+      cell_offsets = record_offsets ? m_read_cell_offsets.data() : nullptr;
+    }
+    m_tape_file.read(chunk + num_carried_chars,
+                     static_cast<std::streamsize>(chunk_size - num_carried_chars));
+    const size_t num_chars = num_carried_chars + static_cast<size_t>(m_tape_file.gcount());
+    const bool last_chunk = m_tape_file.eof();
+
+    const TextCellsParseResult res =
+        Codec::parseBlock(chunk, num_chars, t_buf + num_read_values, t_count - num_read_values,
+                          last_chunk, cell_offsets);
+
+    if (record_offsets) {
+      // Запоминаем смещения пробельных символов перед значениями ячеек,
+      // индексы которых кратны шагу индекса.
+      const size_t stride = m_cell_index.getStride();
+      const size_t first_cell = m_head_pos + num_read_values;
+      for (size_t i = (stride - first_cell % stride) % stride; i < res.num_values; i += stride) {
+        const std::streamoff value_pos = chunk_pos + static_cast<std::streamoff>(cell_offsets[i]);
+        m_cell_index.recordCell(first_cell + i, value_pos > 0 ? value_pos - 1 : 0);
+      }
+    }
+
+    num_read_values += res.num_values;
+
+    if (num_read_values == t_count && res.num_chars < num_chars) {
+      block_end = chunk_pos + static_cast<std::streamoff>(res.num_chars);
+      break;
+    }
+    if (last_chunk || num_read_values == t_count) {
+      break;
+    }
+
+    num_carried_chars = num_chars - res.num_chars;
+    std::memmove(chunk, chunk + res.num_chars, num_carried_chars);
+    chunk_pos += static_cast<std::streamoff>(res.num_chars);
+  }
 
-    m_tape_file.seekp(pos, std::ios::beg);
+  // Пробельные символы в конце непустой ленты означают, что последняя ячейка
+  // уже была считана предыдущим блоком.
+  if (num_read_values == 0 && m_head_pos > 0) {
+    m_tape_file.clear();
+    m_tape_file.seekg(0, std::ios::end);
+    m_end_of_tape_flag = true;
+    completeCellIndex(m_head_pos);
+    return 0;
+  }
+
+  if (num_read_values == 0) {
+    throw BadTapeException(
+        "Не удалось считать значение с ленты. Возможно, в конце файла ленты присутствуют "
+        "лишние пробелы.");
+  }
+
+  m_tape_file.clear();
+  if (block_end >= 0) {
+    // Поддерживаем состояние, при котором любая операция начинается на
+    // пробельном символе непосредственно перед целевым значением.
+    m_tape_file.seekg(block_end, std::ios::beg);
   } else {
+    m_tape_file.seekg(0, std::ios::end);
+    m_end_of_tape_flag = true;
+  }
+
+  m_start_of_tape_flag = false;
+  m_head_pos += num_read_values;
+
+  if (m_end_of_tape_flag) {
+    completeCellIndex(m_head_pos);
+  } else if (record_offsets) {
+    m_cell_index.recordCell(m_head_pos, block_end);
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения чтения и сдвига
+  // для каждой ячейки блока.
+  emulateTapeDevDelay(m_dev_config,
+                      (m_dev_config.read_delay + m_dev_config.shift_delay) * num_read_values);
+
+  return num_read_values;
+}
+
+template <typename T>
+void BasicTapeDev<T>::writeBlock(const T* t_buf, size_t t_count) {
+  if (m_operation_mode == TapeDevOperationMode::Read) {
     throw InvalidOperationException(
         "Запись невозможна. Устройство работает в режиме только чтение.");
   }
-  // Эмулируем время, необходимое устройству для выполнения записи на ленту.
-  std::this_thread::sleep_for(std::chrono::milliseconds(m_dev_config.write_delay));
+
+  if (m_operation_mode == TapeDevOperationMode::ReadWrite) {
+    for (size_t i = 0; i < t_count; ++i) {
+      write(t_buf[i]);
+      shiftRight();
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < t_count; ++i) {
+    appendCellToWriteBuf(t_buf[i]);
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения записи каждой
+  // ячейки блока.
+  emulateTapeDevDelay(m_dev_config,
+                      m_dev_config.write_delay * static_cast<long long>(t_count));
 }
 
-void TapeDev::shiftLeft() {
+template <typename T>
+void BasicTapeDev<T>::shiftLeft() {
   if (m_operation_mode == TapeDevOperationMode::Write) {
     throw InvalidOperationException(
         "В режиме работы устройств TapeDevOperationMode::Write сдвиг влево не поддерживается.");
@@ -265,6 +578,15 @@ void TapeDev::shiftLeft() {
     return;
   }
 
+  stepLeft();
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию влево.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicTapeDev<T>::stepLeft() {
   char ch;
   bool f = false;
 
@@ -284,11 +606,11 @@ void TapeDev::shiftLeft() {
     if (!f && std::isspace(ch)) {
       continue;
     }
-    if (!f && std::isdigit(ch)) {
+    if (!f && Codec::isValueChar(ch)) {
       f = true;
       continue;
     }
-    if (f && std::isdigit(ch)) {
+    if (f && Codec::isValueChar(ch)) {
       continue;
     }
     if (f && std::isspace(ch)) {
@@ -301,12 +623,10 @@ void TapeDev::shiftLeft() {
   if (m_head_pos != 0) {
     m_head_pos -= 1;
   }
-  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
-  // позицию влево.
-  std::this_thread::sleep_for(std::chrono::milliseconds(m_dev_config.shift_delay));
 }
 
-void TapeDev::shiftRight() {
+template <typename T>
+void BasicTapeDev<T>::shiftRight() {
   if (m_operation_mode == TapeDevOperationMode::Write) {
     throw InvalidOperationException(
         "В режиме работы устройств TapeDevOperationMode::Write сдвиг право не поддерживается.");
@@ -322,6 +642,15 @@ void TapeDev::shiftRight() {
     return;
   }
 
+  stepRight();
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
+  // позицию вправо.
+  emulateTapeDevDelay(m_dev_config, m_dev_config.shift_delay);
+}
+
+template <typename T>
+void BasicTapeDev<T>::stepRight() {
   char ch;
   bool f = false;
 
@@ -334,11 +663,11 @@ void TapeDev::shiftRight() {
     if (!f && std::isspace(ch)) {
       continue;
     }
-    if (!f && std::isdigit(ch)) {
+    if (!f && Codec::isValueChar(ch)) {
       f = true;
       continue;
     }
-    if (f && std::isdigit(ch)) {
+    if (f && Codec::isValueChar(ch)) {
       continue;
     }
     if (f && std::isspace(ch)) {
@@ -348,6 +677,9 @@ void TapeDev::shiftRight() {
 
   if (m_tape_file.eof()) {
     m_end_of_tape_flag = true;
+    // Если значение не было пройдено, то головка находилась на пробельных
+    // символах в конце ленты.
+    completeCellIndex(f ? m_head_pos + 1 : m_head_pos);
   } else {
     // Поддерживаем состояние, при котором любая операция начинается на
     // пробельном символе непосредственно перед целевым значением.
@@ -356,12 +688,52 @@ void TapeDev::shiftRight() {
 
   m_head_pos += 1;
 
-  // Эмулируем время, необходимое устройству для выполнения сдвига на одну
-  // позицию вправо.
-  std::this_thread::sleep_for(std::chrono::milliseconds(m_dev_config.shift_delay));
+  if (m_cell_index.isEnabled() && !m_end_of_tape_flag &&
+      m_head_pos % m_cell_index.getStride() == 0) {
+    m_cell_index.recordCell(m_head_pos, m_tape_file.tellg());
+  }
 }
 
-void TapeDev::rewind() {
+template <typename T>
+void BasicTapeDev<T>::seekToCell(size_t t_cell) {
+  if (m_operation_mode == TapeDevOperationMode::Write ||
+      m_operation_mode == TapeDevOperationMode::Append) {
+    throw InvalidOperationException(
+        "В режимах работы устройства TapeDevOperationMode::Write и "
+        "TapeDevOperationMode::Append перемещение головки не поддерживается.");
+  }
+
+  const size_t head_pos = m_head_pos;
+
+  // Ячейка 0 находится в начале файла ленты, даже если индекс отключён.
+  size_t checkpoint_cell = 0;
+  std::streamoff checkpoint_offset = 0;
+  m_cell_index.findCheckpoint(t_cell, checkpoint_cell, checkpoint_offset);
+
+  // Переходим к проиндексированной ячейке, если целевая ячейка находится
+  // позади головки или проиндексированная ячейка ближе к целевой, чем головка.
+  if (t_cell < m_head_pos || checkpoint_cell > m_head_pos) {
+    m_tape_file.clear();
+    m_tape_file.seekg(checkpoint_offset, std::ios::beg);
+    m_tape_file.seekp(checkpoint_offset, std::ios::beg);
+    m_head_pos = checkpoint_cell;
+    m_start_of_tape_flag = checkpoint_cell == 0;
+    m_end_of_tape_flag = false;
+  }
+
+  while (m_head_pos < t_cell && !m_end_of_tape_flag) {
+    stepRight();
+  }
+
+  // Эмулируем время, необходимое устройству для выполнения сдвига на каждую
+  // ячейку пройденного расстояния.
+  const size_t distance = m_head_pos > head_pos ? m_head_pos - head_pos : head_pos - m_head_pos;
+  emulateTapeDevDelay(m_dev_config,
+                      m_dev_config.shift_delay * static_cast<long long>(distance));
+}
+
+template <typename T>
+void BasicTapeDev<T>::rewind() {
   if (m_operation_mode == TapeDevOperationMode::Write) {
     throw InvalidOperationException(
         "В режиме работы устройств TapeDevOperationMode::Write перемотка ленты в начало не "
@@ -380,19 +752,25 @@ void TapeDev::rewind() {
   m_tape_file.seekp(0, std::ios::beg);
   // Отмечаем в состоянии объекта, что находимся в начале ленты.
   m_start_of_tape_flag = true;
+  m_end_of_tape_flag = false;
   m_head_pos = 0;
 
   // Эмулируем время, необходимое устройству для выполнения перемотки ленты в
   // начало.
-  std::this_thread::sleep_for(std::chrono::milliseconds(m_dev_config.rewind_delay));
+  emulateTapeDevDelay(m_dev_config, m_dev_config.rewind_delay);
 }
 
-size_t TapeDev::getHeadPos() const noexcept {
+template <typename T>
+size_t BasicTapeDev<T>::getHeadPos() const noexcept {
   return m_head_pos;
 }
 
-void TapeDev::replaceTape(const std::filesystem::path& t_new_tape_file_path,
-                          TapeDevOperationMode t_mode) {
+template <typename T>
+void BasicTapeDev<T>::replaceTape(const std::filesystem::path& t_new_tape_file_path,
+                                  TapeDevOperationMode t_mode) {
+  // Записываем значения, оставшиеся в буфере записи, на текущую ленту.
+  flush();
+
   m_tape_file_path = t_new_tape_file_path;
   m_operation_mode = t_mode;
 
@@ -421,6 +799,8 @@ void TapeDev::replaceTape(const std::filesystem::path& t_new_tape_file_path,
     m_first_write_flag = true;
   }
 
+  loadCellIndex();
+
   // Сбрасываем флаги состояния.
   m_tape_file.clear();
   m_head_pos = 0;
@@ -433,31 +813,60 @@ void TapeDev::replaceTape(const std::filesystem::path& t_new_tape_file_path,
   }
 }
 
-bool TapeDev::atStartOfTape() const noexcept {
+template <typename T>
+bool BasicTapeDev<T>::isTapeOpen() const noexcept {
+  return m_tape_file.is_open();
+}
+
+template <typename T>
+bool BasicTapeDev<T>::atStartOfTape() const noexcept {
   return m_start_of_tape_flag;
 }
 
-bool TapeDev::atEndOfTape() const noexcept {
+template <typename T>
+bool BasicTapeDev<T>::atEndOfTape() const noexcept {
   return m_end_of_tape_flag;
 }
 
-int TapeDev::getMemBufCurrValue() const noexcept {
+template <typename T>
+T BasicTapeDev<T>::getMemBufCurrValue() const noexcept {
   return m_mem_buf[m_mem_buf_index];
 }
 
-int TapeDev::getMemBufValueAt(size_t t_index) const {
+template <typename T>
+T BasicTapeDev<T>::getMemBufValueAt(size_t t_index) const {
   if (t_index >= m_dev_config.mem_buf_size) {
     throw std::out_of_range("Переданный индекс выходит за границы буфера памяти.");
   }
   return m_mem_buf[t_index];
 }
 
-std::pair<std::vector<int>, size_t> TapeDev::getMemBufCopy() const noexcept {
-  std::vector<int> copy(m_mem_buf, m_mem_buf + m_dev_config.mem_buf_size);
+template <typename T>
+void BasicTapeDev<T>::setMemBufValueAt(size_t t_index, T t_value) {
+  if (t_index >= m_dev_config.mem_buf_size) {
+    throw std::out_of_range("Переданный индекс выходит за границы буфера памяти.");
+  }
+  m_mem_buf[t_index] = t_value;
+}
+
+template <typename T>
+T* BasicTapeDev<T>::getMemBufData() noexcept {
+  return m_mem_buf;
+}
+
+template <typename T>
+BasicMemBufView<T> BasicTapeDev<T>::getMemBufView(size_t t_count) noexcept {
+  return BasicMemBufView<T>{m_mem_buf, std::min(t_count, m_dev_config.mem_buf_size)};
+}
+
+template <typename T>
+std::pair<std::vector<T>, size_t> BasicTapeDev<T>::getMemBufCopy() const noexcept {
+  std::vector<T> copy(m_mem_buf, m_mem_buf + m_dev_config.mem_buf_size);
   return std::make_pair(copy, m_mem_buf_index);
 }
 
-void TapeDev::setMemBuf(const std::vector<int>& t_values) noexcept {
+template <typename T>
+void BasicTapeDev<T>::setMemBuf(const std::vector<T>& t_values) noexcept {
   size_t values_size = t_values.size();
   if (values_size > m_dev_config.mem_buf_size) {
     values_size = m_dev_config.mem_buf_size;
@@ -470,22 +879,41 @@ void TapeDev::setMemBuf(const std::vector<int>& t_values) noexcept {
   // Если размер переданного массива меньше размера буфера памяти, то
   // оставшиеся ячейки заполняем нулями.
   for (size_t i = values_size; i < m_dev_config.mem_buf_size; ++i) {
-    m_mem_buf[i] = 0;
+    m_mem_buf[i] = T();
   }
 
   // Сбрасываем индекс текущей позиции в буфере.
   m_mem_buf_index = 0;
 }
 
-void TapeDev::resetMemBufIndex() noexcept {
+template <typename T>
+void BasicTapeDev<T>::resetMemBufIndex() noexcept {
   m_mem_buf_index = 0;
 }
 
-size_t TapeDev::getDevMemBufSize() const noexcept {
+template <typename T>
+size_t BasicTapeDev<T>::getDevMemBufSize() const noexcept {
   return m_dev_config.mem_buf_size;
 }
 
-TapeDev::~TapeDev() noexcept {
+template <typename T>
+const TapeDevConfig& BasicTapeDev<T>::getDevConfig() const noexcept {
+  return m_dev_config;
+}
+
+template <typename T>
+BasicTapeDev<T>::~BasicTapeDev() noexcept {
+  try {
+    flush();
+  } catch (const BadTapeException& e) {
+    // Деструктор не может сообщить об ошибке: чтобы обнаружить её, следует
+    // вызвать flush() явно.
+  }
   m_tape_file.close();
   delete[] m_mem_buf;
 }
+
+template class BasicTapeDev<std::int32_t>;
+template class BasicTapeDev<std::int64_t>;
+template class BasicTapeDev<std::uint64_t>;
+template class BasicTapeDev<TapeRecord>;
@@ -9,15 +9,42 @@
 #include <vector>
 
 #include "ITapeDev.hpp"
+#include "TapeCellCodec.hpp"
+#include "TapeCellIndex.hpp"
 #include "TapeDevConfig.hpp"
 
-// FIXME: добавить документирующие комментарии.
-/// Перечисление, определяющее возможные режимы работы ленточного устройства.
-enum class TapeDevOperationMode { Read, Write, ReadWrite, Append };
+/*
+ * Структура BasicMemBufView
+ *
+ * Невладеющее представление непрерывного участка буфера памяти устройства
+ * (аналог std::span<T> для C++17). Действительно, пока существует
+ * устройство, которому принадлежит буфер.
+ */
+template <typename T>
+struct BasicMemBufView final {
+  T* data = nullptr;
+  size_t size = 0;
+
+  T* begin() const noexcept { return data; }
+  T* end() const noexcept { return data + size; }
+};
 
-class TapeDev final : public ITapeDev {
+using MemBufView = BasicMemBufView<int>;
+
+/*
+ * Класс BasicTapeDev
+ *
+ * Ленточное устройство, эмулирующее работу с лентой посредством файла в
+ * текстовом формате (см. doc/tape_file_format.md). Значения ячеек
+ * форматируются и разбираются кодеком TapeCellCodec<T>. Шаблон явно
+ * инстанцирован для типов ячеек, для которых определён кодек; устройство для
+ * ячеек типа 'int' доступно под именем TapeDev.
+ */
+template <typename T>
+class BasicTapeDev final : public IBasicTapeDev<T> {
  public:
-  TapeDev(const std::filesystem::path&, const TapeDevConfig&, const TapeDevOperationMode) noexcept;
+  BasicTapeDev(const std::filesystem::path&, const TapeDevConfig&,
+               const TapeDevOperationMode) noexcept;
 
   /// Пытается считать значение из текущей ячейки ленты и записывает его в
   /// текущую позицию в буфере памяти, на которое указывает m_mem_buf_index.
@@ -27,10 +54,23 @@ class TapeDev final : public ITapeDev {
   ///
   /// При достижении конца ленты во время чтения, устанавливает
   /// m_end_of_tape_flag.
-  int read() override;
+  T read() override;
 
-  // FIXME: добавить документирующие комментарии.
-  void write(int) override;
+  /// В режимах TapeDevOperationMode::Write и TapeDevOperationMode::Append
+  /// дописывает значение в конец ленты. Значение попадает в буфер записи,
+  /// который записывается в файл ленты одним вызовом при достижении размера
+  /// kWriteBufSize, при вызове flush(), replaceTape() и при уничтожении
+  /// устройства.
+  ///
+  /// В режиме TapeDevOperationMode::ReadWrite перезаписывает значение в
+  /// текущей ячейке. Если новое значение помещается в ячейку, байты файла
+  /// ленты изменяются на месте; файл ленты перезаписывается целиком, только
+  /// если значение не помещается в ячейку (см. TapeDevConfig::text_cell_width).
+  void write(T) override;
+
+  /// Записывает в файл ленты содержимое буфера записи. Если записать не
+  /// удалось, выбрасывает BadTapeException.
+  void flush() override;
 
   // FIXME: добавить документирующие комментарии.
   void shiftLeft() override;
@@ -41,30 +81,66 @@ class TapeDev final : public ITapeDev {
   // FIXME: добавить документирующие комментарии.
   void rewind() override;
 
+  /// Перемещает головку к ячейке с переданным индексом. Если включён индекс
+  /// смещений ячеек (см. TapeDevConfig::cell_index_stride), головка сразу
+  /// переходит к ближайшей проиндексированной ячейке и проходит по ленте
+  /// только остаток расстояния. В режимах TapeDevOperationMode::Write и
+  /// TapeDevOperationMode::Append выбрасывает InvalidOperationException.
+  void seekToCell(size_t) override;
+
+  /// Считывает значения одним буферизованным проходом по файлу ленты. В
+  /// отличие от read(), не изменяет буфер памяти устройства. Задержки чтения
+  /// и сдвига эмулируются суммарно для всего блока.
+  size_t readBlock(T*, size_t) override;
+
+  /// В режимах TapeDevOperationMode::Write и TapeDevOperationMode::Append
+  /// форматирует весь блок и записывает его в файл ленты одной операцией.
+  /// Задержка записи эмулируется суммарно для всего блока.
+  void writeBlock(const T*, size_t) override;
+
   // FIXME: добавить документирующие комментарии.
-  size_t getHeadPos() const noexcept;
+  size_t getHeadPos() const noexcept override;
 
   // FIXME: добавить документирующие комментарии.
   void replaceTape(const std::filesystem::path&, TapeDevOperationMode);
 
-  bool atStartOfTape() const noexcept;
+  /// Показывает, удалось ли открыть файл ленты.
+  bool isTapeOpen() const noexcept;
+
+  bool atStartOfTape() const noexcept override;
 
-  bool atEndOfTape() const noexcept;
+  bool atEndOfTape() const noexcept override;
 
   /// Возвращает элемент буфера памяти, на который в данный момент указывает
   /// индекс буфера.
-  int getMemBufCurrValue() const noexcept;
+  T getMemBufCurrValue() const noexcept;
 
   /// Возвращает элемент буфера памяти, находящийся на позиции, переданной
   /// в качестве аргумента.
   ///
   /// В случае, если переданный индекс выходит за границы буфера памяти,
   /// выбрасывает исключение std::out_of_range.
-  int getMemBufValueAt(size_t) const;
+  T getMemBufValueAt(size_t) const;
+
+  /// Записывает значение в элемент буфера памяти, находящийся на позиции,
+  /// переданной в качестве первого аргумента.
+  ///
+  /// В случае, если переданный индекс выходит за границы буфера памяти,
+  /// выбрасывает исключение std::out_of_range.
+  void setMemBufValueAt(size_t, T);
+
+  /// Возвращает указатель на начало буфера памяти устройства. Размер буфера
+  /// возвращает getDevMemBufSize().
+  T* getMemBufData() noexcept;
+
+  /// Возвращает представление первых t_count ячеек буфера памяти устройства
+  /// без копирования. Если t_count больше размера буфера, то представление
+  /// охватывает весь буфер.
+  BasicMemBufView<T> getMemBufView(size_t t_count) noexcept;
 
   /// Возвращает пару: копию буфера памяти устройства в текущем состоянии и
   /// индекс текущей позиции в буфере.
-  std::pair<std::vector<int>, size_t> getMemBufCopy() const noexcept;
+  std::pair<std::vector<T>, size_t> getMemBufCopy() const noexcept;
 
   /// Загружает в оперативную память ленточного устройства переданный массив
   /// значений.
@@ -75,23 +151,74 @@ class TapeDev final : public ITapeDev {
   ///
   /// Если размер переданного массива меньше размера буфера памяти, то в
   /// начало буфера памяти запишет переданные значения, а оставшиеся ячейки
-  /// заполнит нулями.
-  void setMemBuf(const std::vector<int>&) noexcept;
+  /// заполнит значениями по умолчанию (нулями).
+  void setMemBuf(const std::vector<T>&) noexcept;
 
   // FIXME: добавить документирующие коментарии.
   void resetMemBufIndex() noexcept;
 
   size_t getDevMemBufSize() const noexcept;
 
-  ~TapeDev() noexcept;
+  /// Возвращает конфигурацию, с которой было создано устройство.
+  const TapeDevConfig& getDevConfig() const noexcept;
+
+  ~BasicTapeDev() noexcept;
+
+  /// Размер буфера записи, при достижении которого буфер записывается в файл
+  /// ленты.
+  static constexpr size_t kWriteBufSize = 64 * 1024;
+
+  /// Наибольший размер порции файла ленты, считываемой за одно обращение к
+  /// файлу при блочном чтении.
+  static constexpr size_t kMaxReadChunkSize = 64 * 1024;
 
  private:
+  using Codec = TapeCellCodec<T>;
+
   /// Выполняет сдвиг считывающей/записывающей магнитной головки на одно
   /// значение назад (влево) на ленте. Функция нужна для метода read(), в
   /// котором использование shiftLeft() вызывает неправильное поведение и
   /// переполнение m_head_pos.
   void doOneStepBackOnTape() noexcept;
 
+  /// Сдвигает головку на одну ячейку влево без эмуляции задержки.
+  void stepLeft();
+
+  /// Сдвигает головку на одну ячейку вправо без эмуляции задержки и
+  /// дополняет индекс смещений ячеек.
+  void stepRight();
+
+  /// Загружает индекс смещений ячеек текущей ленты из файла индекса. Индекс
+  /// используется только в режиме TapeDevOperationMode::Read; в остальных
+  /// режимах устройство изменяет ленту, поэтому файл индекса удаляется.
+  void loadCellIndex();
+
+  /// Отмечает, что последовательный проход дошёл до конца ленты с переданным
+  /// количеством ячеек, и сохраняет индекс смещений ячеек, если он стал
+  /// полным.
+  void completeCellIndex(size_t) noexcept;
+
+  /// Форматирует значение ячейки с учётом TapeDevConfig::text_cell_width.
+  std::string formatCell(T) const;
+
+  /// Дописывает значение ячейки, отформатированное с учётом
+  /// TapeDevConfig::text_cell_width, и предшествующий ему пробел в буфер
+  /// записи. Если буфер достиг размера kWriteBufSize, записывает его в файл
+  /// ленты.
+  void appendCellToWriteBuf(T);
+
+  /// Записывает значение в текущую ячейку ленты в режиме
+  /// TapeDevOperationMode::ReadWrite.
+  void writeInPlace(T);
+
+  /// Устанавливает курсоры файла ленты на пробельный символ перед значением
+  /// ячейки, которое начинается с переданного смещения.
+  void seekToCellStart(std::streamoff);
+
+  /// Перезаписывает файл ленты, заменяя байты в диапазоне [первый аргумент,
+  /// второй аргумент) на переданную строку.
+  void rewriteTapeFileRegion(std::streamoff, std::streamoff, const std::string&);
+
   /// Путь к файлу ленты.
   std::filesystem::path m_tape_file_path;
 
@@ -105,7 +232,7 @@ class TapeDev final : public ITapeDev {
   ///
   /// Если будет заполнен полсностью, новые значения будут перезаписывать
   /// старые из начала.
-  int* m_mem_buf;
+  T* m_mem_buf;
 
   /// Текущая позиция чтения/записи в буфере памяти устройства.
   size_t m_mem_buf_index;
@@ -127,8 +254,25 @@ class TapeDev final : public ITapeDev {
   /// TapeDevOperationMode::Write и TapeDevOperationMode::Append.
   bool m_first_write_flag;
 
+  /// Буфер записи в режимах TapeDevOperationMode::Write и
+  /// TapeDevOperationMode::Append.
+  std::string m_write_buf;
+
+  /// Порция файла ленты при блочном чтении. Буфер переиспользуется между
+  /// вызовами readBlock(), чтобы чтение небольших блоков не выделяло память.
+  std::vector<char> m_read_chunk;
+
+  /// Смещения начала значений порции m_read_chunk, если индекс смещений
+  /// ячеек ещё строится.
+  std::vector<size_t> m_read_cell_offsets;
+
+  /// Индекс смещений ячеек ленты.
+  TapeCellIndex m_cell_index;
+
   /// Файл ленты.
   std::fstream m_tape_file;
 };
 
+using TapeDev = BasicTapeDev<int>;
+
 #endif  // TAPE_DEV_H
@@ -1,12 +1,31 @@
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
+#include <thread>
 
 #include "TapeDevConfig.hpp"
 #include "utils.hpp"
 
 TapeDevConfig::TapeDevConfig()
-    : mem_buf_size(0), read_delay(0), write_delay(0), shift_delay(0), rewind_delay(0) {}
+    : mem_buf_size(0),
+      read_delay(0),
+      write_delay(0),
+      shift_delay(0),
+      rewind_delay(0),
+      tape_drives_count(0),
+      temp_tape_format(TapeFileFormat::Text),
+      text_cell_width(0),
+      cell_index_stride(0),
+      text_tape_backend(TextTapeBackend::Stream),
+      run_generation(RunGenerationStrategy::Chunk),
+      polyphase_tapes_count(0),
+      merge_fan_in(0),
+      run_sort_kernel(RunSortKernel::Auto),
+      sort_workers_count(1),
+      memory_limit(0),
+      cell_type(TapeCellType::Int32),
+      checkpoint_interval(0) {}
 
 TapeDevConfig::TapeDevConfig(const std::filesystem::path& t_cfg_path, size_t t_mem_buf_size,
                              int t_read_delay, int t_write_delay, int t_shift_delay,
@@ -16,14 +35,48 @@ TapeDevConfig::TapeDevConfig(const std::filesystem::path& t_cfg_path, size_t t_m
       read_delay(t_read_delay),
       write_delay(t_write_delay),
       shift_delay(t_shift_delay),
-      rewind_delay(t_rewind_delay) {}
+      rewind_delay(t_rewind_delay),
+      tape_drives_count(0),
+      temp_tape_format(TapeFileFormat::Text),
+      text_cell_width(0),
+      cell_index_stride(0),
+      text_tape_backend(TextTapeBackend::Stream),
+      run_generation(RunGenerationStrategy::Chunk),
+      polyphase_tapes_count(0),
+      merge_fan_in(0),
+      run_sort_kernel(RunSortKernel::Auto),
+      sort_workers_count(1),
+      memory_limit(0),
+      cell_type(TapeCellType::Int32),
+      checkpoint_interval(0) {}
 
 std::string TapeDevConfig::to_string() const {
   return "MemoryBufferSize: " + std::to_string(mem_buf_size) +
          "\nTapeReadDelay: " + std::to_string(read_delay) +
          "\nTapeWriteDelay: " + std::to_string(write_delay) +
          "\nTapeShiftDelay: " + std::to_string(shift_delay) +
-         "\nTapeRewindDelay: " + std::to_string(rewind_delay);
+         "\nTapeRewindDelay: " + std::to_string(rewind_delay) +
+         "\nTapeDrivesCount: " + std::to_string(tape_drives_count) + "\nTempTapeFormat: " +
+         (temp_tape_format == TapeFileFormat::Binary ? "binary" : "text") +
+         "\nTextCellWidth: " + std::to_string(text_cell_width) +
+         "\nCellIndexStride: " + std::to_string(cell_index_stride) + "\nTextTapeBackend: " +
+         (text_tape_backend == TextTapeBackend::Mmap ? "mmap" : "stream") + "\nRunGeneration: " +
+         (run_generation == RunGenerationStrategy::ReplacementSelection ? "replacement_selection"
+          : run_generation == RunGenerationStrategy::PipelinedChunk     ? "pipelined_chunk"
+          : run_generation == RunGenerationStrategy::Natural            ? "natural"
+                                                                        : "chunk") +
+         "\nPolyphaseTapesCount: " + std::to_string(polyphase_tapes_count) +
+         "\nMergeFanIn: " + std::to_string(merge_fan_in) +
+         "\nRunSortKernel: " +
+         (run_sort_kernel == RunSortKernel::Comparison ? "comparison"
+          : run_sort_kernel == RunSortKernel::Radix    ? "radix"
+                                                       : "auto") +
+         "\nSortWorkersCount: " + std::to_string(sort_workers_count) +
+         "\nMemoryLimit: " + std::to_string(memory_limit) +
+         "\nStatsFile: " + stats_file.string() +
+         "\nCellType: " + tapeCellTypeName(cell_type) +
+         "\nCheckpointInterval: " + std::to_string(checkpoint_interval) +
+         "\nDelayMode: " + (virtual_clock ? "virtual" : "sleep");
 }
 
 const TapeDevConfig parseTapeConfigFile(const std::filesystem::path& t_cfgFilePath) {
@@ -63,6 +116,111 @@ const TapeDevConfig parseTapeConfigFile(const std::filesystem::path& t_cfgFilePa
       } else if (stringStartsWith(cfg_line, "TapeRewindDelay:")) {
         value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
         cfg.rewind_delay = value;
+      } else if (stringStartsWith(cfg_line, "TapeDrivesCount:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0) {
+          throw std::runtime_error("Значение 'TapeDrivesCount' не может быть отрицательным.");
+        }
+        cfg.tape_drives_count = value;
+      } else if (stringStartsWith(cfg_line, "PolyphaseTapesCount:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0 || value == 1 || value == 2) {
+          throw std::runtime_error(
+              "Значение 'PolyphaseTapesCount' должно быть равно 0 или быть не меньше 3.");
+        }
+        cfg.polyphase_tapes_count = value;
+      } else if (stringStartsWith(cfg_line, "MergeFanIn:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0 || value == 1) {
+          throw std::runtime_error(
+              "Значение 'MergeFanIn' должно быть равно 0 или быть не меньше 2.");
+        }
+        cfg.merge_fan_in = value;
+      } else if (stringStartsWith(cfg_line, "SortWorkersCount:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 1) {
+          throw std::runtime_error("Значение 'SortWorkersCount' должно быть больше 0.");
+        }
+        cfg.sort_workers_count = value;
+      } else if (stringStartsWith(cfg_line, "DelayMode:")) {
+        const std::string mode = trim_copy(splitAfterDelimiter(cfg_line));
+        if (mode == "sleep") {
+          cfg.virtual_clock.reset();
+        } else if (mode == "virtual") {
+          cfg.virtual_clock = std::make_shared<VirtualClock>();
+        } else {
+          throw std::invalid_argument(mode);
+        }
+      } else if (stringStartsWith(cfg_line, "MemoryLimit:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0) {
+          throw std::runtime_error("Значение 'MemoryLimit' не может быть отрицательным.");
+        }
+        cfg.memory_limit = value;
+      } else if (stringStartsWith(cfg_line, "CheckpointInterval:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0) {
+          throw std::runtime_error("Значение 'CheckpointInterval' не может быть отрицательным.");
+        }
+        cfg.checkpoint_interval = value;
+      } else if (stringStartsWith(cfg_line, "StatsFile:")) {
+        cfg.stats_file = trim_copy(splitAfterDelimiter(cfg_line));
+      } else if (stringStartsWith(cfg_line, "TextCellWidth:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0) {
+          throw std::runtime_error("Значение 'TextCellWidth' не может быть отрицательным.");
+        }
+        cfg.text_cell_width = value;
+      } else if (stringStartsWith(cfg_line, "CellIndexStride:")) {
+        value = std::stoi(trim_copy(splitAfterDelimiter(cfg_line)));
+        if (value < 0) {
+          throw std::runtime_error("Значение 'CellIndexStride' не может быть отрицательным.");
+        }
+        cfg.cell_index_stride = value;
+      } else if (stringStartsWith(cfg_line, "TextTapeBackend:")) {
+        const std::string backend = trim_copy(splitAfterDelimiter(cfg_line));
+        if (backend == "stream") {
+          cfg.text_tape_backend = TextTapeBackend::Stream;
+        } else if (backend == "mmap") {
+          cfg.text_tape_backend = TextTapeBackend::Mmap;
+        } else {
+          throw std::invalid_argument(backend);
+        }
+      } else if (stringStartsWith(cfg_line, "RunGeneration:")) {
+        const std::string strategy = trim_copy(splitAfterDelimiter(cfg_line));
+        if (strategy == "chunk") {
+          cfg.run_generation = RunGenerationStrategy::Chunk;
+        } else if (strategy == "replacement_selection") {
+          cfg.run_generation = RunGenerationStrategy::ReplacementSelection;
+        } else if (strategy == "pipelined_chunk") {
+          cfg.run_generation = RunGenerationStrategy::PipelinedChunk;
+        } else if (strategy == "natural") {
+          cfg.run_generation = RunGenerationStrategy::Natural;
+        } else {
+          throw std::invalid_argument(strategy);
+        }
+      } else if (stringStartsWith(cfg_line, "RunSortKernel:")) {
+        const std::string kernel = trim_copy(splitAfterDelimiter(cfg_line));
+        if (kernel == "auto") {
+          cfg.run_sort_kernel = RunSortKernel::Auto;
+        } else if (kernel == "comparison") {
+          cfg.run_sort_kernel = RunSortKernel::Comparison;
+        } else if (kernel == "radix") {
+          cfg.run_sort_kernel = RunSortKernel::Radix;
+        } else {
+          throw std::invalid_argument(kernel);
+        }
+      } else if (stringStartsWith(cfg_line, "CellType:")) {
+        cfg.cell_type = tapeCellTypeFromName(trim_copy(splitAfterDelimiter(cfg_line)));
+      } else if (stringStartsWith(cfg_line, "TempTapeFormat:")) {
+        const std::string format = trim_copy(splitAfterDelimiter(cfg_line));
+        if (format == "text") {
+          cfg.temp_tape_format = TapeFileFormat::Text;
+        } else if (format == "binary") {
+          cfg.temp_tape_format = TapeFileFormat::Binary;
+        } else {
+          throw std::invalid_argument(format);
+        }
       } else {
         throw std::runtime_error("Неизвестная опция в конфигурационном файле '" +
                                  t_cfgFilePath.string() + "': " + cfg_line + ".");
@@ -77,4 +235,12 @@ const TapeDevConfig parseTapeConfigFile(const std::filesystem::path& t_cfgFilePa
   }
 
   return cfg;
-}
\ No newline at end of file
+}
+
+void emulateTapeDevDelay(const TapeDevConfig& t_dev_config, long long t_delay_ms) {
+  if (t_dev_config.virtual_clock) {
+    t_dev_config.virtual_clock->advance(t_delay_ms);
+  } else if (t_delay_ms > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(t_delay_ms));
+  }
+}
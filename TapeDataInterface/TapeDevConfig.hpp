@@ -3,11 +3,32 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <memory>
 #include <string>
 
+#include "ITapeDev.hpp"
+#include "VirtualClock.hpp"
+
 // TODO: добавить проверку на то, что в конфигурацию передан ненулевой размер
 // буфера памяти устройства.
 
+/// Перечисление, определяющее реализацию устройства для чтения лент в
+/// текстовом формате: посимвольное чтение через std::fstream (TapeDev) или
+/// отображение файла ленты в память (MappedTapeDev).
+enum class TextTapeBackend { Stream, Mmap };
+
+/// Перечисление, определяющее способ формирования отрезков на временных
+/// лентах: разбиение входной ленты на части размером с буфер памяти, выбор
+/// с замещением, конвейерное разбиение на части размером с половину буфера
+/// памяти, при котором чтение одной половины совмещено с записью другой, или
+/// выделение естественных отрезков - уже упорядоченных участков входной ленты.
+enum class RunGenerationStrategy { Chunk, ReplacementSelection, PipelinedChunk, Natural };
+
+/// Перечисление, определяющее алгоритм сортировки отрезков в памяти:
+/// сортировка сравнениями (std::sort), поразрядная сортировка или выбор
+/// алгоритма по размеру отрезка.
+enum class RunSortKernel { Auto, Comparison, Radix };
+
 struct TapeDevConfig final {
 
   TapeDevConfig();
@@ -35,8 +56,74 @@ struct TapeDevConfig final {
   int shift_delay;
   /// Значение задержки при перемотке ленты в начало.
   int rewind_delay;
+  /// Количество дополнительных ленточных устройств (приводов), доступных
+  /// сортировщику помимо основного. Значение 0 означает отсутствие
+  /// ограничения.
+  size_t tape_drives_count;
+  /// Формат файлов временных лент, создаваемых сортировщиком.
+  TapeFileFormat temp_tape_format;
+  /// Ширина ячейки текстовой ленты в символах. Значения, записываемые на
+  /// текстовую ленту, дополняются слева пробелами до этой ширины, что
+  /// позволяет перезаписывать ячейки на месте. Значение 0 означает запись без
+  /// выравнивания.
+  size_t text_cell_width;
+  /// Шаг индекса смещений ячеек текстовой ленты (см. TapeCellIndex): в
+  /// индексе запоминается смещение каждой ячейки, индекс которой кратен шагу.
+  /// Значение 0 отключает индекс.
+  size_t cell_index_stride;
+  /// Реализация устройства, которая используется для чтения лент в текстовом
+  /// формате в режиме TapeDevOperationMode::Read.
+  TextTapeBackend text_tape_backend;
+  /// Способ формирования отрезков на временных лентах.
+  RunGenerationStrategy run_generation;
+  /// Количество временных лент для многофазного слияния. Значение 0 означает
+  /// K-путевое слияние, при котором каждый отрезок записывается на отдельную
+  /// временную ленту.
+  size_t polyphase_tapes_count;
+  /// Наибольшее количество временных лент, сливаемых за один проход K-путевого
+  /// слияния. Если отрезков больше, они сливаются в несколько проходов через
+  /// промежуточные временные ленты. Значение 0 означает слияние всех
+  /// отрезков за один проход.
+  size_t merge_fan_in;
+  /// Алгоритм сортировки отрезков в памяти. Поразрядной сортировке требуется
+  /// вспомогательный буфер размером с сортируемый отрезок.
+  RunSortKernel run_sort_kernel;
+  /// Количество потоков, которые одновременно сортируют отрезки временных
+  /// лент на этапе TapeSorter::forward_pass(). Каждый поток, кроме первого,
+  /// использует собственный буфер размером с буфер памяти устройства.
+  size_t sort_workers_count;
+  /// Ограничение рабочей памяти сортировщика в ячейках (значениях типа
+  /// ячеек ленты). Вся рабочая память сортировщика, включая буфер памяти основного
+  /// устройства, учитывается в арене такой ёмкости (см. MemoryArena), а
+  /// превышение ограничения прерывает сортировку. Значение 0 означает
+  /// отсутствие ограничения.
+  size_t memory_limit;
+  /// Путь к файлу, в который TapeSorter записывает статистику операций с
+  /// лентами в формате JSON по окончании сортировки. Пустой путь отключает
+  /// сбор статистики.
+  std::filesystem::path stats_file;
+  /// Тип ячеек входной, временных и выходной лент (см. TapeCellCodec).
+  TapeCellType cell_type;
+  /// Интервал контрольных точек сортировки в ячейках выходной ленты (см.
+  /// SortCheckpoint). Если значение больше нуля, сортировщик записывает
+  /// контрольную точку после каждого отрезка и после каждых
+  /// checkpoint_interval ячеек, записанных при слиянии, а прерванную
+  /// сортировку можно продолжить методом TapeSorter::resume(). Значение 0
+  /// отключает контрольные точки.
+  size_t checkpoint_interval;
+  /// Виртуальные часы, в которых накапливаются задержки операций устройства
+  /// вместо реального ожидания (режим DelayMode: virtual). Копии конфигурации
+  /// разделяют одни часы, поэтому в них учитываются задержки всех устройств,
+  /// созданных с этой конфигурацией. Пустой указатель означает реальное
+  /// ожидание (режим DelayMode: sleep).
+  std::shared_ptr<VirtualClock> virtual_clock;
 };
 
 const TapeDevConfig parseTapeConfigFile(const std::filesystem::path&);
 
+/// Эмулирует задержку операции устройства с переданной конфигурацией:
+/// продвигает виртуальные часы, если они заданы, иначе приостанавливает
+/// поток на переданное количество миллисекунд.
+void emulateTapeDevDelay(const TapeDevConfig&, long long);
+
 #endif  // TAPE_DEV_CONF
\ No newline at end of file
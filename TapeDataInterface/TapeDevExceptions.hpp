@@ -2,7 +2,9 @@
 #define TAPE_DEV_EXCEPTIONS
 
 #include <exception>
+#include <new>
 #include <stdexcept>
+#include <string>
 
 class EndOfTapeException : public std::exception {
  public:
@@ -31,4 +33,30 @@ class InvalidOperationException : public std::runtime_error {
   const char* what() const noexcept override { return std::runtime_error::what(); }
 };
 
+class TapeDevPoolExhaustedException : public std::runtime_error {
+ public:
+  TapeDevPoolExhaustedException()
+      : std::runtime_error("В пуле не осталось свободных ленточных устройств.") {}
+
+  TapeDevPoolExhaustedException(const std::string& msg) : std::runtime_error(msg) {}
+
+  const char* what() const noexcept override { return std::runtime_error::what(); }
+};
+
+/// Исключение, которое выбрасывает MemoryArena при превышении ограничения
+/// рабочей памяти. Является std::bad_alloc, так как означает неудачное
+/// выделение памяти.
+class MemoryLimitExceededException : public std::bad_alloc {
+ public:
+  MemoryLimitExceededException()
+      : m_msg("Превышено ограничение рабочей памяти сортировщика.") {}
+
+  MemoryLimitExceededException(const std::string& msg) : m_msg(msg) {}
+
+  const char* what() const noexcept override { return m_msg.c_str(); }
+
+ private:
+  std::string m_msg;
+};
+
 #endif  // TAPE_DEV_EXCEPTIONS
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <vector>
+
+#include "BinaryTapeDev.hpp"
+#include "MappedTapeDev.hpp"
+#include "TapeDev.hpp"
+#include "TapeDevExceptions.hpp"
+#include "TapeDevFactory.hpp"
+
+TapeFileFormat tapeFileFormatFromPath(const std::filesystem::path& t_tape_file_path) noexcept {
+  if (t_tape_file_path.extension() == kBinaryTapeFileExtension) {
+    return TapeFileFormat::Binary;
+  }
+  return TapeFileFormat::Text;
+}
+
+template <typename T>
+std::unique_ptr<IBasicTapeDev<T>> makeTapeDev(const std::filesystem::path& t_tape_file_path,
+                                              const TapeDevConfig& t_dev_config,
+                                              TapeDevOperationMode t_mode) {
+  if (tapeFileFormatFromPath(t_tape_file_path) == TapeFileFormat::Binary) {
+    return std::make_unique<BasicBinaryTapeDev<T>>(t_tape_file_path, t_dev_config, t_mode);
+  }
+
+  if (t_mode == TapeDevOperationMode::Read &&
+      t_dev_config.text_tape_backend == TextTapeBackend::Mmap) {
+    return std::make_unique<BasicMappedTapeDev<T>>(t_tape_file_path, t_dev_config, t_mode);
+  }
+
+  auto tape_dev = std::make_unique<BasicTapeDev<T>>(t_tape_file_path, t_dev_config, t_mode);
+
+  // Конструктор TapeDev не проверяет успешность открытия файла ленты, поэтому
+  // выполняем проверку здесь.
+  if (!tape_dev->isTapeOpen()) {
+    throw BadTapeException("Не удалось отктыть файл ленты '" + t_tape_file_path.string() + "'.");
+  }
+
+  return tape_dev;
+}
+
+template <typename T>
+size_t convertTapeFile(const std::filesystem::path& t_input_tape_file_path,
+                       const std::filesystem::path& t_output_tape_file_path) {
+  // Преобразование не эмулирует работу устройства, поэтому задержки нулевые.
+  const TapeDevConfig dev_config("", 1, 0, 0, 0, 0);
+
+  auto input_tape_dev =
+      makeTapeDev<T>(t_input_tape_file_path, dev_config, TapeDevOperationMode::Read);
+  auto output_tape_dev =
+      makeTapeDev<T>(t_output_tape_file_path, dev_config, TapeDevOperationMode::Write);
+
+  std::vector<T> block(4096);
+  size_t num_values = 0;
+  while (!input_tape_dev->atEndOfTape()) {
+    const size_t num_read_values = input_tape_dev->readBlock(block.data(), block.size());
+    output_tape_dev->writeBlock(block.data(), num_read_values);
+    num_values += num_read_values;
+  }
+  output_tape_dev->flush();
+
+  return num_values;
+}
+
+template std::unique_ptr<IBasicTapeDev<std::int32_t>> makeTapeDev<std::int32_t>(
+    const std::filesystem::path&, const TapeDevConfig&, TapeDevOperationMode);
+template std::unique_ptr<IBasicTapeDev<std::int64_t>> makeTapeDev<std::int64_t>(
+    const std::filesystem::path&, const TapeDevConfig&, TapeDevOperationMode);
+template std::unique_ptr<IBasicTapeDev<std::uint64_t>> makeTapeDev<std::uint64_t>(
+    const std::filesystem::path&, const TapeDevConfig&, TapeDevOperationMode);
+template std::unique_ptr<IBasicTapeDev<TapeRecord>> makeTapeDev<TapeRecord>(
+    const std::filesystem::path&, const TapeDevConfig&, TapeDevOperationMode);
+template size_t convertTapeFile<std::int32_t>(const std::filesystem::path&,
+                                              const std::filesystem::path&);
+template size_t convertTapeFile<std::int64_t>(const std::filesystem::path&,
+                                              const std::filesystem::path&);
+template size_t convertTapeFile<std::uint64_t>(const std::filesystem::path&,
+                                               const std::filesystem::path&);
+template size_t convertTapeFile<TapeRecord>(const std::filesystem::path&,
+                                            const std::filesystem::path&);
@@ -0,0 +1,38 @@
+#ifndef TAPE_DEV_FACTORY_HPP
+#define TAPE_DEV_FACTORY_HPP
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "ITapeDev.hpp"
+#include "TapeDevConfig.hpp"
+
+/// Расширение файлов лент в бинарном формате.
+inline const std::string kBinaryTapeFileExtension = ".bin";
+
+/// Определяет формат файла ленты по расширению файла: файлы с расширением
+/// ".bin" считаются лентами в бинарном формате, остальные - в текстовом.
+TapeFileFormat tapeFileFormatFromPath(const std::filesystem::path&) noexcept;
+
+/// Создаёт устройство, соответствующее формату файла ленты, и устанавливает
+/// на него ленту в переданном режиме работы. Для чтения лент в текстовом
+/// формате используется реализация, заданная в
+/// TapeDevConfig::text_tape_backend. Параметр шаблона задаёт тип ячеек ленты.
+///
+/// Если файл ленты не удалось открыть, выбрасывает BadTapeException.
+template <typename T = int>
+std::unique_ptr<IBasicTapeDev<T>> makeTapeDev(const std::filesystem::path&, const TapeDevConfig&,
+                                              TapeDevOperationMode);
+
+/// Переписывает ленту из первого файла во второй. Формат каждого файла
+/// определяется его расширением, поэтому функция используется для
+/// преобразования лент между текстовым и бинарным форматами. Задержки
+/// устройства при преобразовании не эмулируются. Параметр шаблона задаёт тип
+/// ячеек ленты.
+///
+/// Возвращает количество переписанных ячеек.
+template <typename T = int>
+size_t convertTapeFile(const std::filesystem::path&, const std::filesystem::path&);
+
+#endif  // TAPE_DEV_FACTORY_HPP
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "InstrumentedTapeDev.hpp"
+#include "TapeDevExceptions.hpp"
+#include "TapeDevFactory.hpp"
+#include "TapeDevPool.hpp"
+
+template <typename T>
+BasicTapeDevPool<T>::BasicTapeDevPool(const TapeDevConfig& t_dev_config) noexcept
+    : m_dev_config(t_dev_config),
+      m_max_devs(t_dev_config.tape_drives_count),
+      m_devs(),
+      m_stats(),
+      m_stats_enabled_flag(!t_dev_config.stats_file.empty()) {
+  m_dev_config.mem_buf_size = 1;
+}
+
+template <typename T>
+IBasicTapeDev<T>& BasicTapeDevPool<T>::acquire(const std::filesystem::path& t_tape_file_path,
+                                            TapeDevOperationMode t_mode) {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+
+  if (m_max_devs != 0 && m_devs.size() >= m_max_devs) {
+    throw TapeDevPoolExhaustedException(
+        "Не удалось установить ленту '" + t_tape_file_path.string() +
+        "': все ленточные устройства пула заняты (TapeDrivesCount: " +
+        std::to_string(m_max_devs) + ").");
+  }
+
+  if (!m_stats_enabled_flag) {
+    m_devs.push_back(makeTapeDev<T>(t_tape_file_path, m_dev_config, t_mode));
+    return *m_devs.back();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_ptr<IBasicTapeDev<T>> tape_dev =
+      makeTapeDev<T>(t_tape_file_path, m_dev_config, t_mode);
+  const auto real_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  m_stats.record(t_tape_file_path, TapeDevOperation::TapeSwap, 0, 0, real_time.count());
+
+  m_devs.push_back(std::make_unique<BasicInstrumentedTapeDev<T>>(
+      std::move(tape_dev), t_tape_file_path, m_dev_config, t_mode, m_stats));
+
+  return *m_devs.back();
+}
+
+template <typename T>
+void BasicTapeDevPool<T>::release(IBasicTapeDev<T>& t_tape_dev) noexcept {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+
+  auto it = std::find_if(m_devs.begin(), m_devs.end(),
+                         [&t_tape_dev](const auto& dev) { return dev.get() == &t_tape_dev; });
+  if (it != m_devs.end()) {
+    m_devs.erase(it);
+  }
+}
+
+template <typename T>
+void BasicTapeDevPool<T>::releaseAll() noexcept {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+
+  m_devs.clear();
+}
+
+template <typename T>
+size_t BasicTapeDevPool<T>::getMaxDevs() const noexcept {
+  return m_max_devs;
+}
+
+template <typename T>
+size_t BasicTapeDevPool<T>::getNumDevsInUse() const noexcept {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+
+  return m_devs.size();
+}
+
+template <typename T>
+void BasicTapeDevPool<T>::setStatsEnabled(bool t_enabled) noexcept {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+  m_stats_enabled_flag = t_enabled;
+}
+
+template <typename T>
+bool BasicTapeDevPool<T>::isStatsEnabled() const noexcept {
+  std::lock_guard<std::mutex> lock(m_devs_mutex);
+  return m_stats_enabled_flag;
+}
+
+template <typename T>
+TapeDevStats& BasicTapeDevPool<T>::getStats() noexcept {
+  return m_stats;
+}
+
+template class BasicTapeDevPool<std::int32_t>;
+template class BasicTapeDevPool<std::int64_t>;
+template class BasicTapeDevPool<std::uint64_t>;
+template class BasicTapeDevPool<TapeRecord>;
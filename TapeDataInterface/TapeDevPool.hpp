@@ -0,0 +1,101 @@
+#ifndef TAPE_DEV_POOL_HPP
+#define TAPE_DEV_POOL_HPP
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ITapeDev.hpp"
+#include "TapeDevConfig.hpp"
+#include "TapeDevStats.hpp"
+
+/*
+ * Класс BasicTapeDevPool
+ *
+ * Пул ленточных устройств (приводов). Каждое выданное пулом устройство имеет
+ * собственную считывающую/записывающую головку и собственный открытый файл
+ * ленты, поэтому переключение между лентами не требует закрытия/открытия
+ * файлов и не приводит к потере позиции головки.
+ *
+ * Тип устройства выбирается по формату файла ленты (см. makeTapeDev()).
+ *
+ * Рабочей памятью сортировщика является буфер памяти основного устройства,
+ * поэтому устройства пула создаются с буфером памяти из одной ячейки, в
+ * которую помещается значение, считанное головкой.
+ *
+ * Выдача и возврат устройств потокобезопасны, что позволяет нескольким
+ * потокам сортировщика работать с разными лентами одновременно. Каждое
+ * выданное устройство используется только одним потоком.
+ *
+ * При включённом сборе статистики каждое выданное устройство оборачивается в
+ * InstrumentedTapeDev, а каждая установка ленты учитывается как операция
+ * TapeDevOperation::TapeSwap.
+ *
+ * Пул выдаёт устройства для ячеек типа T. Пул устройств для ячеек типа 'int'
+ * доступен под именем TapeDevPool.
+ */
+template <typename T>
+class BasicTapeDevPool final {
+ public:
+  /// Создаёт пул устройств с переданной конфигурацией. Максимальное
+  /// количество одновременно выданных устройств задаётся полем
+  /// TapeDevConfig::tape_drives_count (0 - без ограничения). Сбор статистики
+  /// включается, если задано поле TapeDevConfig::stats_file.
+  explicit BasicTapeDevPool(const TapeDevConfig&) noexcept;
+
+  /// Выдаёт устройство, на которое установлена лента, расположенная по
+  /// переданному пути, в переданном режиме работы.
+  ///
+  /// Если все устройства пула заняты, выбрасывает
+  /// TapeDevPoolExhaustedException. Если не удалось открыть файл ленты,
+  /// выбрасывает BadTapeException.
+  IBasicTapeDev<T>& acquire(const std::filesystem::path&, TapeDevOperationMode);
+
+  /// Возвращает устройство в пул. Файл ленты устройства закрывается.
+  void release(IBasicTapeDev<T>&) noexcept;
+
+  /// Возвращает в пул все выданные устройства.
+  void releaseAll() noexcept;
+
+  /// Возвращает максимальное количество одновременно выданных устройств
+  /// (0 - без ограничения).
+  size_t getMaxDevs() const noexcept;
+
+  /// Возвращает количество выданных в данный момент устройств.
+  size_t getNumDevsInUse() const noexcept;
+
+  /// Включает или отключает сбор статистики для устройств, выдаваемых после
+  /// вызова.
+  void setStatsEnabled(bool) noexcept;
+
+  /// Показывает, включён ли сбор статистики.
+  bool isStatsEnabled() const noexcept;
+
+  /// Возвращает статистику операций устройств пула.
+  TapeDevStats& getStats() noexcept;
+
+ private:
+  /// Конфигурация, с которой создаются устройства пула.
+  TapeDevConfig m_dev_config;
+
+  /// Максимальное количество одновременно выданных устройств.
+  size_t m_max_devs;
+
+  /// Выданные в данный момент устройства.
+  std::vector<std::unique_ptr<IBasicTapeDev<T>>> m_devs;
+
+  /// Защищает список выданных устройств.
+  mutable std::mutex m_devs_mutex;
+
+  /// Статистика операций устройств пула.
+  TapeDevStats m_stats;
+
+  /// Показывает, что выдаваемые устройства оборачиваются для сбора
+  /// статистики.
+  bool m_stats_enabled_flag;
+};
+
+using TapeDevPool = BasicTapeDevPool<int>;
+
+#endif  // TAPE_DEV_POOL_HPP
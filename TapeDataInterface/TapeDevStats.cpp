@@ -0,0 +1,183 @@
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "TapeDevStats.hpp"
+
+namespace {
+
+size_t histogramBucket(uint64_t t_value) noexcept {
+  size_t bucket = 0;
+  while (t_value > 0 && bucket + 1 < TapeOperationStats::kNumHistogramBuckets) {
+    t_value >>= 1;
+    bucket += 1;
+  }
+  return bucket;
+}
+
+/// Записывает гистограмму без завершающих пустых корзин.
+void appendHistogramJson(std::string& t_json, const char* t_name,
+                         const std::array<uint64_t, TapeOperationStats::kNumHistogramBuckets>&
+                             t_histogram) {
+  size_t num_buckets = t_histogram.size();
+  while (num_buckets > 0 && t_histogram.at(num_buckets - 1) == 0) {
+    num_buckets -= 1;
+  }
+
+  t_json += ", \"";
+  t_json += t_name;
+  t_json += "\": [";
+  for (size_t i = 0; i < num_buckets; ++i) {
+    if (i > 0) {
+      t_json += ", ";
+    }
+    t_json += std::to_string(t_histogram.at(i));
+  }
+  t_json += "]";
+}
+
+void appendTapeStatsJson(std::string& t_json, const TapeStats& t_stats,
+                         const std::string& t_indent) {
+  t_json += "{";
+  bool first = true;
+  for (size_t op = 0; op < kNumTapeDevOperations; ++op) {
+    const TapeOperationStats& op_stats = t_stats.at(op);
+    if (op_stats.calls == 0) {
+      continue;
+    }
+
+    t_json += first ? "\n" : ",\n";
+    first = false;
+
+    t_json += t_indent + "  \"" + tapeDevOperationName(static_cast<TapeDevOperation>(op)) +
+              "\": {\"calls\": " + std::to_string(op_stats.calls) +
+              ", \"cells\": " + std::to_string(op_stats.cells) +
+              ", \"emulated_time_ms\": " + std::to_string(op_stats.emulated_time_ms) +
+              ", \"real_time_ns\": " + std::to_string(op_stats.real_time_ns);
+    appendHistogramJson(t_json, "emulated_time_ms_histogram", op_stats.emulated_time_ms_histogram);
+    appendHistogramJson(t_json, "real_time_ns_histogram", op_stats.real_time_ns_histogram);
+    t_json += "}";
+  }
+  t_json += first ? "}" : "\n" + t_indent + "}";
+}
+
+/// Экранирует строку для записи в JSON.
+std::string escapeJson(const std::string& t_str) {
+  std::string res;
+  res.reserve(t_str.size());
+  for (const char ch : t_str) {
+    if (ch == '"' || ch == '\\') {
+      res += '\\';
+      res += ch;
+    } else if (static_cast<unsigned char>(ch) < 0x20) {
+      res += ' ';
+    } else {
+      res += ch;
+    }
+  }
+  return res;
+}
+
+}  // namespace
+
+const char* tapeDevOperationName(TapeDevOperation t_operation) noexcept {
+  switch (t_operation) {
+    case TapeDevOperation::Read:
+      return "read";
+    case TapeDevOperation::Write:
+      return "write";
+    case TapeDevOperation::ShiftLeft:
+      return "shift_left";
+    case TapeDevOperation::ShiftRight:
+      return "shift_right";
+    case TapeDevOperation::Rewind:
+      return "rewind";
+    default:
+      return "tape_swap";
+  }
+}
+
+void TapeOperationStats::add(uint64_t t_cells, uint64_t t_emulated_time_ms,
+                             uint64_t t_real_time_ns) noexcept {
+  calls += 1;
+  cells += t_cells;
+  emulated_time_ms += t_emulated_time_ms;
+  real_time_ns += t_real_time_ns;
+  emulated_time_ms_histogram.at(histogramBucket(t_emulated_time_ms)) += 1;
+  real_time_ns_histogram.at(histogramBucket(t_real_time_ns)) += 1;
+}
+
+void TapeOperationStats::merge(const TapeOperationStats& t_other) noexcept {
+  calls += t_other.calls;
+  cells += t_other.cells;
+  emulated_time_ms += t_other.emulated_time_ms;
+  real_time_ns += t_other.real_time_ns;
+  for (size_t i = 0; i < kNumHistogramBuckets; ++i) {
+    emulated_time_ms_histogram.at(i) += t_other.emulated_time_ms_histogram.at(i);
+    real_time_ns_histogram.at(i) += t_other.real_time_ns_histogram.at(i);
+  }
+}
+
+void TapeDevStats::record(const std::filesystem::path& t_tape_file_path,
+                          TapeDevOperation t_operation, uint64_t t_cells,
+                          uint64_t t_emulated_time_ms, uint64_t t_real_time_ns) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_tapes[t_tape_file_path.string()]
+      .at(static_cast<size_t>(t_operation))
+      .add(t_cells, t_emulated_time_ms, t_real_time_ns);
+}
+
+TapeStats TapeDevStats::getTapeStats(const std::filesystem::path& t_tape_file_path) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_tapes.find(t_tape_file_path.string());
+  return it != m_tapes.end() ? it->second : TapeStats{};
+}
+
+TapeStats TapeDevStats::getTotalStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  TapeStats total{};
+  for (const auto& [path, tape_stats] : m_tapes) {
+    for (size_t op = 0; op < kNumTapeDevOperations; ++op) {
+      total.at(op).merge(tape_stats.at(op));
+    }
+  }
+  return total;
+}
+
+void TapeDevStats::reset() noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_tapes.clear();
+}
+
+std::string TapeDevStats::toJson() const {
+  const TapeStats total = getTotalStats();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string json = "{\n  \"total\": ";
+  appendTapeStatsJson(json, total, "  ");
+  json += ",\n  \"tapes\": [";
+
+  bool first = true;
+  for (const auto& [path, tape_stats] : m_tapes) {
+    json += first ? "\n" : ",\n";
+    first = false;
+    json += "    {\"path\": \"" + escapeJson(path) + "\", \"operations\": ";
+    appendTapeStatsJson(json, tape_stats, "    ");
+    json += "}";
+  }
+  json += first ? "]\n}\n" : "\n  ]\n}\n";
+
+  return json;
+}
+
+void TapeDevStats::writeJson(const std::filesystem::path& t_json_file_path) const {
+  std::ofstream output(t_json_file_path, std::ios::out | std::ios::trunc);
+
+  if (!output.is_open()) {
+    throw std::runtime_error("Не удалось открыть для записи файл статистики '" +
+                             t_json_file_path.string() + "'.");
+  }
+
+  output << toJson();
+}
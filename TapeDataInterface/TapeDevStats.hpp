@@ -0,0 +1,104 @@
+#ifndef TAPE_DEV_STATS_HPP
+#define TAPE_DEV_STATS_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+/// Перечисление типов операций с лентой, которые учитываются статистикой.
+/// TapeSwap - установка ленты на устройство пула.
+enum class TapeDevOperation { Read, Write, ShiftLeft, ShiftRight, Rewind, TapeSwap };
+
+/// Количество типов операций в TapeDevOperation.
+inline constexpr size_t kNumTapeDevOperations = 6;
+
+/// Возвращает имя операции, которое используется в отчёте.
+const char* tapeDevOperationName(TapeDevOperation) noexcept;
+
+/*
+ * Структура TapeOperationStats
+ *
+ * Статистика одного типа операций на одной ленте. Гистограммы строятся по
+ * отдельным вызовам операции: корзина 0 содержит вызовы с нулевой
+ * длительностью, корзина i > 0 - вызовы с длительностью из [2^(i-1), 2^i).
+ */
+struct TapeOperationStats final {
+  /// Количество корзин гистограмм.
+  static constexpr size_t kNumHistogramBuckets = 40;
+
+  /// Количество вызовов операции.
+  uint64_t calls = 0;
+  /// Количество ячеек, обработанных операцией. Блочные операции обрабатывают
+  /// несколько ячеек за один вызов.
+  uint64_t cells = 0;
+  /// Суммарное эмулируемое время операции по задержкам из конфигурации
+  /// устройства, мс.
+  uint64_t emulated_time_ms = 0;
+  /// Суммарное реальное время выполнения операции, нс.
+  uint64_t real_time_ns = 0;
+  /// Гистограмма эмулируемого времени вызовов, мс.
+  std::array<uint64_t, kNumHistogramBuckets> emulated_time_ms_histogram{};
+  /// Гистограмма реального времени вызовов, нс.
+  std::array<uint64_t, kNumHistogramBuckets> real_time_ns_histogram{};
+
+  /// Добавляет к статистике вызов операции.
+  void add(uint64_t t_cells, uint64_t t_emulated_time_ms, uint64_t t_real_time_ns) noexcept;
+
+  /// Добавляет к статистике другую статистику той же операции.
+  void merge(const TapeOperationStats&) noexcept;
+};
+
+/// Статистика всех типов операций на одной ленте.
+using TapeStats = std::array<TapeOperationStats, kNumTapeDevOperations>;
+
+/*
+ * Класс TapeDevStats
+ *
+ * Накапливает статистику операций с лентами: количество вызовов и ячеек,
+ * эмулируемое и реальное время и их гистограммы по каждому типу операций на
+ * каждой ленте. Позволяет сравнивать алгоритмы по эмулируемой стоимости
+ * работы с лентами, а не по времени выполнения программы.
+ *
+ * Методы класса потокобезопасны.
+ */
+class TapeDevStats final {
+ public:
+  TapeDevStats() = default;
+
+  TapeDevStats(const TapeDevStats&) = delete;
+
+  TapeDevStats& operator=(const TapeDevStats&) = delete;
+
+  /// Учитывает вызов операции на ленте, расположенной по переданному пути.
+  /// Аргументы: путь к файлу ленты, тип операции, количество обработанных
+  /// ячеек, эмулируемое время (мс) и реальное время (нс) вызова.
+  void record(const std::filesystem::path&, TapeDevOperation, uint64_t, uint64_t, uint64_t);
+
+  /// Возвращает статистику ленты, расположенной по переданному пути. Если
+  /// операций с лентой не было, то возвращает пустую статистику.
+  TapeStats getTapeStats(const std::filesystem::path&) const;
+
+  /// Возвращает статистику операций, просуммированную по всем лентам.
+  TapeStats getTotalStats() const;
+
+  /// Сбрасывает накопленную статистику.
+  void reset() noexcept;
+
+  /// Возвращает статистику в формате JSON (см. doc/tape_dev_stats.md).
+  std::string toJson() const;
+
+  /// Записывает статистику в формате JSON в переданный файл.
+  void writeJson(const std::filesystem::path&) const;
+
+ private:
+  /// Статистика по каждой ленте. Ключ - путь к файлу ленты.
+  std::map<std::string, TapeStats> m_tapes;
+
+  /// Защищает статистику лент.
+  mutable std::mutex m_mutex;
+};
+
+#endif  // TAPE_DEV_STATS_HPP
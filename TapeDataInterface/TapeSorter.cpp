@@ -1,276 +1,1200 @@
 #include <algorithm>
+#include <deque>
+#include <atomic>
 #include <exception>
 #include <limits>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+#include "RunSort.hpp"
+#include "TapeCellIndex.hpp"
 #include "TapeDevExceptions.hpp"
+#include "TapeDevFactory.hpp"
 #include "TapeSorter.hpp"
 
-TapeSorter::TapeSorter(TapeDev& t_tape_dev, const std::filesystem::path& t_target_tape_file_path,
-                       const std::filesystem::path& t_output_tape_file_path,
-                       const std::filesystem::path& t_data_dir_path) noexcept
+template <typename T, typename Compare>
+BasicTapeSorter<T, Compare>::BasicTapeSorter(BasicTapeDev<T>& t_tape_dev,
+                                             const std::filesystem::path& t_target_tape_file_path,
+                                             const std::filesystem::path& t_output_tape_file_path,
+                                             const std::filesystem::path& t_data_dir_path,
+                                             const Compare& t_compare) noexcept
     : m_tape_dev(t_tape_dev),
+      m_own_tape_dev_pool(std::make_unique<BasicTapeDevPool<T>>(t_tape_dev.getDevConfig())),
+      m_tape_dev_pool(*m_own_tape_dev_pool),
+      m_compare(t_compare),
       m_target_tape_file_path(t_target_tape_file_path),
       m_output_tape_file_path(t_output_tape_file_path),
       m_data_dir_path(t_data_dir_path),
+      m_memory_arena(t_tape_dev.getDevConfig().memory_limit * sizeof(T)),
       m_shortcut_flag(false),
-      m_num_values_on_temp_tapes(),
+      m_runs_sorted_flag(false),
+      m_num_values_on_temp_tapes(&m_memory_arena),
       m_temp_tapes_counter(0),
-      m_values_counter(0) {}
+      m_values_counter(0),
+      m_runs_counter(0),
+      m_run_sort_scratch(&m_memory_arena),
+      m_checkpoint(&m_memory_arena),
+      m_emulated_time_ms(0),
+      m_polyphase_tape_devs(&m_memory_arena),
+      m_polyphase_runs(&m_memory_arena),
+      m_polyphase_dummy_runs(&m_memory_arena),
+      m_polyphase_perfect_runs(&m_memory_arena),
+      m_polyphase_tape_idx(0) {}
+
+template <typename T, typename Compare>
+BasicTapeSorter<T, Compare>::BasicTapeSorter(BasicTapeDev<T>& t_tape_dev,
+                                             BasicTapeDevPool<T>& t_tape_dev_pool,
+                                             const std::filesystem::path& t_target_tape_file_path,
+                                             const std::filesystem::path& t_output_tape_file_path,
+                                             const std::filesystem::path& t_data_dir_path,
+                                             const Compare& t_compare) noexcept
+    : m_tape_dev(t_tape_dev),
+      m_own_tape_dev_pool(nullptr),
+      m_tape_dev_pool(t_tape_dev_pool),
+      m_compare(t_compare),
+      m_target_tape_file_path(t_target_tape_file_path),
+      m_output_tape_file_path(t_output_tape_file_path),
+      m_data_dir_path(t_data_dir_path),
+      m_memory_arena(t_tape_dev.getDevConfig().memory_limit * sizeof(T)),
+      m_shortcut_flag(false),
+      m_runs_sorted_flag(false),
+      m_num_values_on_temp_tapes(&m_memory_arena),
+      m_temp_tapes_counter(0),
+      m_values_counter(0),
+      m_runs_counter(0),
+      m_run_sort_scratch(&m_memory_arena),
+      m_checkpoint(&m_memory_arena),
+      m_emulated_time_ms(0),
+      m_polyphase_tape_devs(&m_memory_arena),
+      m_polyphase_runs(&m_memory_arena),
+      m_polyphase_dummy_runs(&m_memory_arena),
+      m_polyphase_perfect_runs(&m_memory_arena),
+      m_polyphase_tape_idx(0) {}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::sort() {
+  sortImpl(false);
+}
+
+template <typename T, typename Compare>
+bool BasicTapeSorter<T, Compare>::resume() {
+  return sortImpl(true);
+}
+
+template <typename T, typename Compare>
+bool BasicTapeSorter<T, Compare>::sortImpl(bool t_resume) {
+  // Конфигурация может быть создана без parseTapeConfigFile(), поэтому
+  // количество входов слияния проверяется до начала сортировки: при одном
+  // входе слияние не уменьшало бы количество отрезков.
+  if (m_tape_dev.getDevConfig().merge_fan_in == 1) {
+    throw std::runtime_error(
+        "Не удалось выполнить сортировку. Причина: значение 'MergeFanIn' должно быть равно 0 "
+        "или быть не меньше 2.");
+  }
+
+  m_tape_dev_pool.getStats().reset();
+
+  const std::shared_ptr<VirtualClock>& virtual_clock = m_tape_dev.getDevConfig().virtual_clock;
+  const uint64_t start_time_ms = virtual_clock ? virtual_clock->getElapsedMs() : 0;
+
+  // Буфер памяти основного устройства является частью рабочей памяти
+  // сортировщика, поэтому учитывается в арене на время сортировки.
+  m_memory_arena.resetPeak();
+  const size_t mem_buf_bytes = m_tape_dev.getDevMemBufSize() * sizeof(T);
 
-void TapeSorter::sort() {
   try {
-    setup();
+    m_memory_arena.reserve(mem_buf_bytes, "буфера памяти основного устройства");
   } catch (const std::exception& e) {
     throw std::runtime_error("Не удалось выполнить сортировку. Причина: " + std::string(e.what()));
   }
 
-  if (m_shortcut_flag) {
-    // Копия буфера памяти устройства для сортировки со всеми значениями с
-    // входной ленты.
-    std::vector<int> buf_to_sort = m_tape_dev.getMemBufCopy().first;
-
-    // Сортируем вектор значений стандартным std::sort(...).
-    std::sort(buf_to_sort.begin(), buf_to_sort.end());
+  const std::filesystem::path manifest_path = SortCheckpoint::manifestPath(m_data_dir_path);
+  bool resumed_flag = false;
 
-    // Пишем отсортированные значения на выходную ленту и завершаем сортировку.
-    try {
-      m_tape_dev.replaceTape(m_output_tape_file_path, TapeDevOperationMode::Write);
-    } catch (const BadTapeException& e) {
-      throw std::runtime_error("Не удалось выполнить сортировку. Причина: " +
-                               std::string(e.what()));
-    }
+  try {
+    resetSortState();
+    initCheckpoint();
 
-    for (size_t i = 0; i < buf_to_sort.size(); ++i) {
+    if (t_resume && isCheckpointing()) {
+      SortCheckpoint saved_checkpoint(&m_memory_arena);
+      bool loaded_flag = false;
       try {
-        m_tape_dev.write(buf_to_sort.at(i));
-      } catch (const BadTapeException& e) {
-        throw std::runtime_error("Не удалось выполнить сортировку. Причина: " +
-                                 std::string(e.what()));
+        loaded_flag = saved_checkpoint.load(manifest_path);
+      } catch (const std::runtime_error&) {
+        // Повреждённый манифест не позволяет продолжить сортировку, но не
+        // мешает выполнить её заново: манифест удаляется ниже.
+      }
+      if (loaded_flag && saved_checkpoint.isSameSort(m_checkpoint)) {
+        restoreFromCheckpoint(saved_checkpoint);
+        resumed_flag = true;
       }
     }
-  } else {
-    try {
-      forward_pass();
-      backward_pass();
-    } catch (const std::exception& e) {
-      throw std::runtime_error("Не удалось выполнить сортировку. Причина: " +
-                               std::string(e.what()));
+
+    // Контрольная точка предыдущей сортировки перестаёт соответствовать
+    // временным лентам, как только они перезаписываются.
+    if (!resumed_flag) {
+      std::filesystem::remove(manifest_path);
+    }
+
+    if (!resumed_flag || !m_checkpoint.runs_complete) {
+      setup();
+    }
+
+    if (m_shortcut_flag) {
+      // Все значения с входной ленты уже находятся в буфере памяти устройства:
+      // сортируем их на месте, без копирования буфера.
+      const BasicMemBufView<T> buf_to_sort = m_tape_dev.getMemBufView(m_values_counter);
+      if (m_tape_dev.getDevConfig().run_generation == RunGenerationStrategy::Natural) {
+        sortPresortedBlock(buf_to_sort.data, buf_to_sort.size);
+      } else {
+        sortRun(buf_to_sort.data, buf_to_sort.size, m_tape_dev.getDevConfig().run_sort_kernel,
+                m_run_sort_scratch, m_compare);
+      }
+
+      // Пишем отсортированные значения на выходную ленту и завершаем сортировку.
+      IBasicTapeDev<T>& output_tape_dev =
+          m_tape_dev_pool.acquire(m_output_tape_file_path, TapeDevOperationMode::Write);
+      output_tape_dev.writeBlock(buf_to_sort.data, buf_to_sort.size);
+      output_tape_dev.flush();
+      m_tape_dev_pool.release(output_tape_dev);
+    } else {
+      if (isCheckpointing()) {
+        // После продолжения сортировки часть отрезков может быть уже
+        // отсортирована, даже если остальные отрезки не сортировались.
+        m_runs_sorted_flag = std::find(m_checkpoint.runs_sorted.begin(),
+                                       m_checkpoint.runs_sorted.end(),
+                                       false) == m_checkpoint.runs_sorted.end();
+        m_checkpoint.input_cells = m_values_counter;
+        m_checkpoint.runs_complete = true;
+        saveCheckpoint();
+      }
+
+      // Отрезки, полученные методом выбора с замещением, уже отсортированы.
+      if (!m_runs_sorted_flag) {
+        forward_pass();
+      }
+      if (isPolyphase()) {
+        polyphase_pass();
+      } else {
+        backward_pass();
+      }
     }
+  } catch (const std::exception& e) {
+    m_tape_dev_pool.releaseAll();
+    m_memory_arena.unreserve(mem_buf_bytes);
+    throw std::runtime_error("Не удалось выполнить сортировку. Причина: " + std::string(e.what()));
   }
 
+  m_memory_arena.unreserve(mem_buf_bytes);
+
   doAfterSortCleanup();
+
+  m_emulated_time_ms = virtual_clock ? virtual_clock->getElapsedMs() - start_time_ms : 0;
+
+  // Записываем статистику операций с лентами, если это задано конфигурацией.
+  const std::filesystem::path& stats_file = m_tape_dev.getDevConfig().stats_file;
+  if (!stats_file.empty()) {
+    m_tape_dev_pool.getStats().writeJson(stats_file);
+  }
+
+  return resumed_flag;
 }
 
-void TapeSorter::setup() {
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::setup() {
   // Если в выходном файле остались какие-либо данные, то заранее удалим их.
   std::fstream output_tape_file(m_output_tape_file_path, std::ios::out | std::ios::trunc);
   output_tape_file.close();
 
-  m_tape_dev.resetMemBufIndex();
+  // Входная лента остаётся на одном устройстве пула на протяжении всего этапа
+  // подготовки, поэтому после выгрузки очередной порции значений на временную
+  // ленту чтение продолжается с текущей позиции головки.
+  IBasicTapeDev<T>& input_tape_dev =
+      m_tape_dev_pool.acquire(m_target_tape_file_path, TapeDevOperationMode::Read);
 
-  // Количество значений, которое было считано с входной ленты в данной
-  // итерации.
-  size_t num_read_values = 0;
-
-  // Так как в процессе подготовки мы меняем ленты, то состояние входной ленты
-  // теряется. Достигли мы конца входной ленты или нет, будем хранить в
-  // отдельном флаге.
-  bool end_of_input_tape_flag = false;
+  // При продолжении сортировки значения, вошедшие в завершённые отрезки,
+  // повторно не считываются.
+  if (m_values_counter > 0) {
+    input_tape_dev.seekToCell(m_values_counter);
+  }
 
   // Делаем попытку прочитать все значения с ленты в буфер памяти.
-  for (size_t i = 0; i < m_tape_dev.getDevMemBufSize(); ++i) {
-    try {
-      m_tape_dev.read();
-      num_read_values += 1;
-      m_tape_dev.shiftRight();
-    } catch (const BadTapeException& e) {
-      throw e;
-    } catch (const EndOfTapeException& e) {
-      throw e;
+  size_t num_read_values = loadMemBufFromTape(input_tape_dev);
+
+  if (input_tape_dev.atEndOfTape() && m_runs_counter == 0) {
+    m_tape_dev_pool.release(input_tape_dev);
+    m_shortcut_flag = true;
+    m_values_counter = num_read_values;
+    return;
+  }
+
+  // Все значения из входной ленты сразу не поместились в память устройства,
+  // поэтому осуществляем подготовку временных лент.
+  if (isPolyphase()) {
+    setupPolyphaseTapes();
+  }
+
+  const RunGenerationStrategy run_generation = m_tape_dev.getDevConfig().run_generation;
+  if (num_read_values == 0) {
+    // Все значения входной ленты уже вошли в завершённые отрезки.
+  } else if (run_generation == RunGenerationStrategy::ReplacementSelection) {
+    generateRunsByReplacementSelection(input_tape_dev, num_read_values);
+  } else if (run_generation == RunGenerationStrategy::PipelinedChunk &&
+             m_tape_dev.getDevMemBufSize() >= 2) {
+    generatePipelinedChunkRuns(input_tape_dev, num_read_values);
+  } else if (run_generation == RunGenerationStrategy::Natural) {
+    generateNaturalRuns(input_tape_dev, num_read_values);
+  } else {
+    generateChunkRuns(input_tape_dev, num_read_values);
+  }
+
+  m_tape_dev_pool.release(input_tape_dev);
+}
+
+template <typename T, typename Compare>
+bool BasicTapeSorter<T, Compare>::isPolyphase() const noexcept {
+  return m_tape_dev.getDevConfig().polyphase_tapes_count != 0;
+}
+
+template <typename T, typename Compare>
+bool BasicTapeSorter<T, Compare>::isCheckpointing() const noexcept {
+  return m_tape_dev.getDevConfig().checkpoint_interval != 0 && !isPolyphase();
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::initCheckpoint() {
+  m_checkpoint.input_tape = std::filesystem::absolute(m_target_tape_file_path).string();
+  m_checkpoint.input_size = std::filesystem::file_size(m_target_tape_file_path);
+  m_checkpoint.output_tape = std::filesystem::absolute(m_output_tape_file_path).string();
+  m_checkpoint.cell_type = TapeCellCodec<T>::kName;
+  m_checkpoint.order = typeid(Compare).name();
+  m_checkpoint.temp_tape_extension = tempTapeFilePath(0).extension().string();
+
+  m_checkpoint.input_cells = 0;
+  m_checkpoint.runs_complete = false;
+  m_checkpoint.run_sizes.clear();
+  m_checkpoint.run_sizes.shrink_to_fit();
+  m_checkpoint.runs_sorted.clear();
+  m_checkpoint.runs_sorted.shrink_to_fit();
+  m_checkpoint.merge_output_cells = 0;
+  m_checkpoint.merge_output_bytes = 0;
+  m_checkpoint.merge_consumed.clear();
+  m_checkpoint.merge_consumed.shrink_to_fit();
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::resetSortState() {
+  m_shortcut_flag = false;
+  m_runs_sorted_flag = false;
+  m_temp_tapes_counter = 0;
+  m_values_counter = 0;
+  m_runs_counter = 0;
+  m_emulated_time_ms = 0;
+
+  // Контейнеры освобождают память, чтобы она не учитывалась в арене рабочей
+  // памяти следующей сортировки.
+  m_num_values_on_temp_tapes.clear();
+  m_num_values_on_temp_tapes.shrink_to_fit();
+  m_polyphase_tape_devs.clear();
+  m_polyphase_tape_devs.shrink_to_fit();
+  m_polyphase_runs.clear();
+  m_polyphase_runs.shrink_to_fit();
+  m_polyphase_dummy_runs.clear();
+  m_polyphase_dummy_runs.shrink_to_fit();
+  m_polyphase_perfect_runs.clear();
+  m_polyphase_perfect_runs.shrink_to_fit();
+  m_polyphase_tape_idx = 0;
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::restoreFromCheckpoint(const SortCheckpoint& t_checkpoint) {
+  m_checkpoint.input_cells = t_checkpoint.input_cells;
+  m_checkpoint.runs_complete = t_checkpoint.runs_complete;
+  m_checkpoint.run_sizes.assign(t_checkpoint.run_sizes.begin(), t_checkpoint.run_sizes.end());
+  m_checkpoint.runs_sorted.assign(t_checkpoint.runs_sorted.begin(),
+                                  t_checkpoint.runs_sorted.end());
+  m_checkpoint.merge_output_cells = t_checkpoint.merge_output_cells;
+  m_checkpoint.merge_output_bytes = t_checkpoint.merge_output_bytes;
+  m_checkpoint.merge_consumed.assign(t_checkpoint.merge_consumed.begin(),
+                                     t_checkpoint.merge_consumed.end());
+
+  // Завершённый отрезок с индексом i записан на временную ленту с тем же
+  // индексом.
+  const size_t num_runs = m_checkpoint.run_sizes.size();
+  m_temp_tapes_counter = num_runs;
+  m_runs_counter = num_runs;
+  m_values_counter = m_checkpoint.input_cells;
+  m_num_values_on_temp_tapes.assign(m_checkpoint.run_sizes.begin(),
+                                    m_checkpoint.run_sizes.end());
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::saveCheckpoint() const {
+  if (isCheckpointing()) {
+    m_checkpoint.save(SortCheckpoint::manifestPath(m_data_dir_path));
+  }
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::setupPolyphaseTapes() {
+  const size_t num_tapes = m_tape_dev.getDevConfig().polyphase_tapes_count;
+  if (num_tapes < 3) {
+    throw std::runtime_error("для многофазного слияния требуется не менее трёх лент.");
+  }
+
+  const size_t num_input_tapes = num_tapes - 1;
+
+  for (size_t i = 0; i < num_tapes; ++i) {
+    makeTempTape();
+  }
+
+  for (size_t i = 0; i < num_input_tapes; ++i) {
+    m_polyphase_tape_devs.push_back(
+        &m_tape_dev_pool.acquire(tempTapeFilePath(i), TapeDevOperationMode::Write));
+  }
+
+  // Распределение первого уровня: по одному отрезку на каждую входную ленту.
+  // Последний элемент соответствует выходной ленте и всегда равен 0.
+  m_polyphase_runs.assign(num_tapes, {});
+  m_polyphase_perfect_runs.assign(num_tapes, 1);
+  m_polyphase_perfect_runs.back() = 0;
+  m_polyphase_dummy_runs = m_polyphase_perfect_runs;
+  m_polyphase_tape_idx = 0;
+
+  // Отрезки, записываемые на ленты многофазного слияния, сортируются ещё на
+  // этапе подготовки.
+  m_runs_sorted_flag = true;
+}
+
+template <typename T, typename Compare>
+size_t BasicTapeSorter<T, Compare>::selectPolyphaseTape() noexcept {
+  std::pmr::vector<size_t>& perfect = m_polyphase_perfect_runs;
+  std::pmr::vector<size_t>& dummy = m_polyphase_dummy_runs;
+  size_t& j = m_polyphase_tape_idx;
+
+  // Первый отрезок всегда записывается на первую ленту.
+  if (m_runs_counter > 0) {
+    if (dummy.at(j) < dummy.at(j + 1)) {
+      j += 1;
+    } else {
+      if (dummy.at(j) == 0) {
+        // Все фиктивные отрезки текущего уровня заменены реальными, поэтому
+        // переходим к совершенному распределению следующего уровня.
+        const size_t first = perfect.at(0);
+        for (size_t i = 0; i + 1 < perfect.size(); ++i) {
+          dummy.at(i) = first + perfect.at(i + 1) - perfect.at(i);
+          perfect.at(i) = first + perfect.at(i + 1);
+        }
+      }
+      j = 0;
     }
+  }
+
+  dummy.at(j) -= 1;
+  return j;
+}
+
+template <typename T, typename Compare>
+IBasicTapeDev<T>& BasicTapeSorter<T, Compare>::beginRun() {
+  if (isPolyphase()) {
+    return *m_polyphase_tape_devs.at(selectPolyphaseTape());
+  }
+
+  makeTempTape();
+  return m_tape_dev_pool.acquire(tempTapeFilePath(m_temp_tapes_counter - 1),
+                                 TapeDevOperationMode::Write);
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::endRun(IBasicTapeDev<T>& t_temp_tape_dev, size_t t_run_size,
+                                         bool t_sorted) {
+  m_runs_counter += 1;
+  m_values_counter += t_run_size;
+
+  if (isPolyphase()) {
+    m_polyphase_runs.at(m_polyphase_tape_idx).push_back(t_run_size);
+    return;
+  }
+
+  m_num_values_on_temp_tapes.push_back(t_run_size);
+  t_temp_tape_dev.flush();
+  m_tape_dev_pool.release(t_temp_tape_dev);
 
-    if (m_tape_dev.atEndOfTape() && i <= m_tape_dev.getDevMemBufSize()) {
-      m_shortcut_flag = true;
+  // Списки контрольной точки выделяются из арены рабочей памяти, поэтому
+  // заполняются, только если контрольные точки включены.
+  if (!isCheckpointing()) {
+    return;
+  }
+
+  m_checkpoint.run_sizes.push_back(t_run_size);
+  m_checkpoint.runs_sorted.push_back(t_sorted);
+
+  // При выборе с замещением значения, отложенные до следующего отрезка, уже
+  // считаны с входной ленты, поэтому завершённые отрезки не составляют её
+  // начала и контрольная точка записывается только после формирования всех
+  // отрезков.
+  if (m_tape_dev.getDevConfig().run_generation != RunGenerationStrategy::ReplacementSelection) {
+    m_checkpoint.input_cells = m_values_counter;
+    saveCheckpoint();
+  }
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::generateChunkRuns(IBasicTapeDev<T>& t_input_tape_dev,
+                                                    size_t t_num_read_values) {
+  size_t num_read_values = t_num_read_values;
+
+  while (true) {
+    // При многофазном слиянии отрезки должны быть отсортированы до
+    // распределения по лентам, так как одна лента хранит несколько отрезков.
+    if (isPolyphase()) {
+      sortRun(m_tape_dev.getMemBufData(), num_read_values,
+              m_tape_dev.getDevConfig().run_sort_kernel, m_run_sort_scratch, m_compare);
+    }
+
+    IBasicTapeDev<T>& temp_tape_dev = beginRun();
+    temp_tape_dev.writeBlock(m_tape_dev.getMemBufData(), num_read_values);
+    endRun(temp_tape_dev, num_read_values, isPolyphase());
+
+    // На данном этапе последние считанные значения записаны на временную
+    // ленту, поэтому просто выходим из цикла.
+    if (t_input_tape_dev.atEndOfTape()) {
+      break;
+    }
+
+    // Считываем в память новую порцию значений с входной ленты.
+    num_read_values = loadMemBufFromTape(t_input_tape_dev);
+    if (num_read_values == 0) {
       break;
     }
   }
+}
 
-  // Если все значения из входной ленты сразу не поместились в память
-  // устройства, то осуществляем подготовку временных лент.
-  if (!m_shortcut_flag) {
-    size_t input_tape_curr_head_pos = 0;
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::generateRunsByReplacementSelection(
+    IBasicTapeDev<T>& t_input_tape_dev, size_t t_num_read_values) {
+  // Буфер памяти устройства делится на три области:
+  //   [0, heap_size)                  - куча значений текущего отрезка с
+  //                                     наименьшим значением на вершине;
+  //   [heap_size, next_run_start)     - свободные ячейки, которые появляются
+  //                                     после исчерпания входной ленты;
+  //   [next_run_start, num_values)    - значения, которые меньше последнего
+  //                                     записанного и поэтому попадут только в
+  //                                     следующий отрезок.
+  T* buf = m_tape_dev.getMemBufData();
+  size_t num_values = t_num_read_values;
+  size_t heap_size = num_values;
+  size_t next_run_start = num_values;
 
-    while (true) {
-      input_tape_curr_head_pos = m_tape_dev.getHeadPos();
+  const auto heap_cmp = [this](const T& t_lhs, const T& t_rhs) {
+    return m_compare(t_rhs, t_lhs);
+  };
 
-      m_num_values_on_temp_tapes.push_back(num_read_values);
+  // Входная лента считывается небольшими блоками в промежуточный буфер, из
+  // которого значения по одному поступают в кучу: чтение по одной ячейке
+  // обходится блочному чтению заметно дороже в пересчёте на ячейку.
+  const size_t staging_buf_size = std::max<size_t>(
+      1, std::min(m_tape_dev.getDevMemBufSize(), kInputStagingBufBytes / sizeof(T)));
+  std::pmr::vector<T> staging_buf(staging_buf_size, &m_memory_arena);
+  size_t staging_pos = 0;
+  size_t staging_size = 0;
+  const auto read_next_value = [&](T& t_value) {
+    if (staging_pos == staging_size) {
+      staging_pos = 0;
+      staging_size = t_input_tape_dev.atEndOfTape()
+                         ? 0
+                         : t_input_tape_dev.readBlock(staging_buf.data(), staging_buf.size());
+      if (staging_size == 0) {
+        return false;
+      }
+    }
+    t_value = staging_buf[staging_pos++];
+    return true;
+  };
 
-      m_values_counter += num_read_values;
+  while (heap_size > 0) {
+    std::make_heap(buf, buf + heap_size, heap_cmp);
 
-      try {
-        makeTempTape();
-      } catch (const std::runtime_error& e) {
-        throw e;
-      }
+    IBasicTapeDev<T>& temp_tape_dev = beginRun();
+    size_t run_size = 0;
 
-      // Так как мы уже заполнили буфер памяти новыми значениями, то сначала
-      // выгрузим их на временну ленту.
-      std::vector<int> buf_to_write = m_tape_dev.getMemBufCopy().first;
-      m_tape_dev.replaceTape(m_temp_tape_file_paths.at(m_temp_tapes_counter - 1),
-                             TapeDevOperationMode::Write);
-      for (size_t i = 0; i < num_read_values; ++i) {
-        try {
-          m_tape_dev.write(buf_to_write.at(i));
-        } catch (const BadTapeException& e) {
-          throw e;
-        }
+    while (heap_size > 0) {
+      std::pop_heap(buf, buf + heap_size, heap_cmp);
+      const T last_value = buf[heap_size - 1];
+      temp_tape_dev.write(last_value);
+      run_size += 1;
+
+      T value{};
+      if (!read_next_value(value)) {
+        // Входная лента исчерпана: куча просто уменьшается.
+        heap_size -= 1;
+      } else if (!m_compare(value, last_value)) {
+        // Значение продолжает текущий отрезок.
+        buf[heap_size - 1] = value;
+        std::push_heap(buf, buf + heap_size, heap_cmp);
+      } else {
+        // Значение откладывается до следующего отрезка. Пока входная лента не
+        // исчерпана, свободных ячеек нет и освободившаяся ячейка кучи
+        // примыкает к области следующего отрезка.
+        heap_size -= 1;
+        next_run_start = heap_size;
+        buf[next_run_start] = value;
       }
+    }
 
-      // На данном этапе последние считанные значения записаны на временную
-      // ленту, поэтому просто выходим из цикла.
-      if (end_of_input_tape_flag) {
-        break;
+    endRun(temp_tape_dev, run_size, true);
+
+    // Значения следующего отрезка переносим в начало буфера памяти.
+    std::copy(buf + next_run_start, buf + num_values, buf);
+    num_values -= next_run_start;
+    heap_size = num_values;
+    next_run_start = num_values;
+  }
+
+  m_runs_sorted_flag = true;
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::generatePipelinedChunkRuns(IBasicTapeDev<T>& t_input_tape_dev,
+                                                             size_t t_num_read_values) {
+  T* buf = m_tape_dev.getMemBufData();
+  const size_t half_size = m_tape_dev.getDevMemBufSize() / 2;
+
+  // Половины буфера памяти и количество значений в каждой из них.
+  T* halves[2] = {buf, buf + half_size};
+  const size_t half_sizes[2] = {half_size, m_tape_dev.getDevMemBufSize() - half_size};
+  size_t num_values[2] = {std::min(t_num_read_values, half_sizes[0]),
+                          t_num_read_values - std::min(t_num_read_values, half_sizes[0])};
+
+  // Обе половины уже заполнены, поэтому первая записывается без перекрытия.
+  spillSortedRun(halves[0], num_values[0]);
+
+  size_t curr = 1;
+  while (num_values[curr] > 0) {
+    const size_t next = curr ^ 1;
+
+    // Входная лента используется только потоком чтения, пока основной поток
+    // работает с временными лентами.
+    std::future<size_t> reader = std::async(std::launch::async, [&, next]() -> size_t {
+      if (t_input_tape_dev.atEndOfTape()) {
+        return 0;
       }
+      return t_input_tape_dev.readBlock(halves[next], half_sizes[next]);
+    });
+
+    spillSortedRun(halves[curr], num_values[curr]);
+
+    num_values[next] = reader.get();
+    curr = next;
+  }
+
+  m_runs_sorted_flag = true;
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::generateNaturalRuns(IBasicTapeDev<T>& t_input_tape_dev,
+                                                      size_t t_num_read_values) {
+  T* buf = m_tape_dev.getMemBufData();
+  size_t num_read_values = t_num_read_values;
+
+  // Текущий отрезок: устройство, на которое он записывается, количество
+  // значений и последнее записанное значение.
+  IBasicTapeDev<T>* run_tape_dev = nullptr;
+  size_t run_size = 0;
+  T last_value{};
+
+  // Дописывает упорядоченные значения к текущему отрезку или, если первое
+  // значение меньше последнего записанного, начинает с них новый отрезок.
+  const auto append_to_run = [&](const T* t_values, size_t t_num_values) {
+    if (t_num_values == 0) {
+      return;
+    }
+    if (run_tape_dev != nullptr && m_compare(t_values[0], last_value)) {
+      endRun(*run_tape_dev, run_size, true);
+      run_tape_dev = nullptr;
+    }
+    if (run_tape_dev == nullptr) {
+      run_tape_dev = &beginRun();
+      run_size = 0;
+    }
+    run_tape_dev->writeBlock(t_values, t_num_values);
+    run_size += t_num_values;
+    last_value = t_values[t_num_values - 1];
+  };
 
-      // Готовимся считывать новую порцию значений с входной ленты.
-      num_read_values = 0;
-      m_tape_dev.replaceTape(m_target_tape_file_path, TapeDevOperationMode::Read);
+  while (num_read_values > 0) {
+    T* const end = buf + num_read_values;
 
-      // Перемещаем считывающую/записывающую магнитную головку в позицию,
-      // на которой остановились.
-      for (int i = 0; i < input_tape_curr_head_pos; ++i) {
-        m_tape_dev.shiftRight();
+    // Граница естественных отрезков внутри блока. Блок не сортируется, если
+    // обе его части упорядочены, а первая продолжает текущий отрезок: вторая
+    // часть, вероятно, продолжится в следующем блоке. Иначе разделение блока
+    // лишь увеличило бы количество отрезков.
+    T* split = std::is_sorted_until(buf, end, m_compare);
+    if (split != end) {
+      const bool continues_run = run_tape_dev != nullptr && !m_compare(buf[0], last_value);
+      if (!continues_run || !std::is_sorted(split, end, m_compare)) {
+        sortPresortedBlock(buf, num_read_values);
+        split = end;
       }
+    }
+    append_to_run(buf, split - buf);
+    append_to_run(split, end - split);
+
+    if (t_input_tape_dev.atEndOfTape()) {
+      break;
+    }
+    num_read_values = loadMemBufFromTape(t_input_tape_dev);
+  }
+
+  if (run_tape_dev != nullptr) {
+    endRun(*run_tape_dev, run_size, true);
+  }
+
+  m_runs_sorted_flag = true;
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::sortPresortedBlock(T* t_values, size_t t_num_values) {
+  T* const end = t_values + t_num_values;
+  if (std::is_sorted(t_values, end, m_compare)) {
+    return;
+  }
+
+  // Проверяется строгое убывание: при обращении блока с равными значениями
+  // их порядок изменился бы.
+  const auto not_descending = [this](const T& t_lhs, const T& t_rhs) {
+    return !m_compare(t_rhs, t_lhs);
+  };
+  if (std::adjacent_find(t_values, end, not_descending) == end) {
+    std::reverse(t_values, end);
+    return;
+  }
+
+  sortRun(t_values, t_num_values, m_tape_dev.getDevConfig().run_sort_kernel, m_run_sort_scratch,
+          m_compare);
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::spillSortedRun(T* t_values, size_t t_num_values) {
+  sortRun(t_values, t_num_values, m_tape_dev.getDevConfig().run_sort_kernel, m_run_sort_scratch,
+          m_compare);
 
-      // Считываем в память новую порцию значений с входной ленты.
-      for (size_t i = 0; i < m_tape_dev.getDevMemBufSize(); ++i) {
-        try {
-          m_tape_dev.read();
-          num_read_values += 1;
-          m_tape_dev.shiftRight();
-        } catch (const BadTapeException& e) {
-          throw e;
-        } catch (const EndOfTapeException& e) {
-          throw e;
+  IBasicTapeDev<T>& temp_tape_dev = beginRun();
+  temp_tape_dev.writeBlock(t_values, t_num_values);
+  endRun(temp_tape_dev, t_num_values, true);
+}
+
+template <typename T, typename Compare>
+size_t BasicTapeSorter<T, Compare>::loadMemBufFromTape(IBasicTapeDev<T>& t_tape_dev) {
+  return t_tape_dev.readBlock(m_tape_dev.getMemBufData(), m_tape_dev.getDevMemBufSize());
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::forward_pass() {
+  const size_t num_temp_tapes = m_temp_tapes_counter;
+
+  // Каждому потоку требуется собственное устройство пула, поэтому количество
+  // потоков ограничено количеством приводов.
+  size_t num_workers = std::min(m_tape_dev.getDevConfig().sort_workers_count, num_temp_tapes);
+  if (m_tape_dev_pool.getMaxDevs() != 0) {
+    num_workers = std::min(num_workers, m_tape_dev_pool.getMaxDevs());
+  }
+  num_workers = std::max<size_t>(num_workers, 1);
+
+  // Индекс следующей временной ленты, которую предстоит отсортировать.
+  std::atomic<size_t> next_temp_tape_idx(0);
+  std::atomic<bool> failed_flag(false);
+  std::exception_ptr first_error;
+  std::mutex error_mutex;
+  std::mutex checkpoint_mutex;
+
+  auto worker = [&](T* t_buf, RunSortScratch<T>* t_scratch) {
+    try {
+      for (size_t i = next_temp_tape_idx++; i < num_temp_tapes && !failed_flag;
+           i = next_temp_tape_idx++) {
+        if (!isCheckpointing()) {
+          sortTempTape(i, t_buf, *t_scratch);
+          continue;
         }
-        if (m_tape_dev.atEndOfTape()) {
-          end_of_input_tape_flag = true;
-          break;
+
+        {
+          // Отрезки, отсортированные до прерывания сортировки, пропускаются.
+          std::lock_guard<std::mutex> lock(checkpoint_mutex);
+          if (m_checkpoint.runs_sorted.at(i)) {
+            continue;
+          }
         }
+
+        sortTempTape(i, t_buf, *t_scratch);
+
+        std::lock_guard<std::mutex> lock(checkpoint_mutex);
+        m_checkpoint.runs_sorted.at(i) = true;
+        saveCheckpoint();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!failed_flag.exchange(true)) {
+        first_error = std::current_exception();
       }
     }
+  };
+
+  // Первый поток - вызывающий, он использует буфер памяти основного
+  // устройства. Остальным потокам выделяются собственные буферы, а также
+  // вспомогательные буферы поразрядной сортировки. Все буферы выделяются из
+  // арены рабочей памяти.
+  const size_t buf_size = m_tape_dev.getDevMemBufSize();
+  std::pmr::vector<std::pmr::vector<T>> worker_bufs(&m_memory_arena);
+  worker_bufs.reserve(num_workers - 1);
+  for (size_t w = 0; w + 1 < num_workers; ++w) {
+    worker_bufs.emplace_back(buf_size);
+  }
+  std::pmr::vector<RunSortScratch<T>> worker_scratches(num_workers - 1, &m_memory_arena);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers - 1);
+  for (size_t w = 0; w + 1 < num_workers; ++w) {
+    workers.emplace_back(worker, worker_bufs.at(w).data(), &worker_scratches.at(w));
+  }
+
+  worker(m_tape_dev.getMemBufData(), &m_run_sort_scratch);
+
+  for (std::thread& t : workers) {
+    t.join();
+  }
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
   }
 }
 
-void TapeSorter::forward_pass() {
-  for (size_t i = 0; i < m_temp_tape_file_paths.size(); ++i) {
-    m_tape_dev.replaceTape(m_temp_tape_file_paths.at(i), TapeDevOperationMode::Read);
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::sortTempTape(size_t t_temp_tape_idx, T* t_buf,
+                                               RunSortScratch<T>& t_scratch) {
+  const std::filesystem::path temp_tape_file_path = tempTapeFilePath(t_temp_tape_idx);
 
-    m_tape_dev.resetMemBufIndex();
+  IBasicTapeDev<T>& input_temp_tape_dev =
+      m_tape_dev_pool.acquire(temp_tape_file_path, TapeDevOperationMode::Read);
+  const size_t num_values =
+      input_temp_tape_dev.readBlock(t_buf, m_num_values_on_temp_tapes.at(t_temp_tape_idx));
+  m_tape_dev_pool.release(input_temp_tape_dev);
 
-    for (size_t i = 0; i < m_tape_dev.getDevMemBufSize(); ++i) {
-      try {
-        m_tape_dev.read();
-        m_tape_dev.shiftRight();
-      } catch (const BadTapeException& e) {
-        throw e;
-      } catch (const EndOfTapeException& e) {
-        throw e;
-      }
-      if (m_tape_dev.atEndOfTape()) {
-        break;
+  sortRun(t_buf, num_values, m_tape_dev.getDevConfig().run_sort_kernel, t_scratch, m_compare);
+
+  // Если контрольные точки включены, отсортированный отрезок записывается в
+  // отдельный файл, который затем заменяет временную ленту: иначе сбой во
+  // время записи уничтожил бы несортированный отрезок.
+  const std::filesystem::path sorted_temp_tape_file_path =
+      isCheckpointing() ? sortedTempTapeFilePath(t_temp_tape_idx) : temp_tape_file_path;
+
+  IBasicTapeDev<T>& temp_tape_dev =
+      m_tape_dev_pool.acquire(sorted_temp_tape_file_path, TapeDevOperationMode::Write);
+  temp_tape_dev.writeBlock(t_buf, num_values);
+  temp_tape_dev.flush();
+  m_tape_dev_pool.release(temp_tape_dev);
+
+  if (sorted_temp_tape_file_path != temp_tape_file_path) {
+    std::filesystem::rename(sorted_temp_tape_file_path, temp_tape_file_path);
+    std::filesystem::remove(TapeCellIndex::indexFilePath(sorted_temp_tape_file_path));
+    std::filesystem::remove(TapeCellIndex::indexFilePath(temp_tape_file_path));
+  }
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::backward_pass() {
+  // Временные ленты, на которых остались отрезки. Ленты, слитые в
+  // промежуточные, имеют нулевую длину и уже удалены.
+  std::pmr::vector<size_t> temp_tape_idxs(&m_memory_arena);
+  for (size_t i = 0; i < m_temp_tapes_counter; ++i) {
+    if (m_num_values_on_temp_tapes.at(i) > 0) {
+      temp_tape_idxs.push_back(i);
+    }
+  }
+
+  // Единственный отсортированный отрезок (например, после выбора с замещением
+  // на почти отсортированной входной ленте) уже является выходной лентой.
+  if (temp_tape_idxs.size() == 1 &&
+      tapeFileFormatFromPath(tempTapeFilePath(temp_tape_idxs.front())) ==
+          tapeFileFormatFromPath(m_output_tape_file_path)) {
+    std::error_code ec;
+    std::filesystem::rename(tempTapeFilePath(temp_tape_idxs.front()), m_output_tape_file_path,
+                            ec);
+    if (!ec) {
+      return;
+    }
+  }
+
+  // Если отрезков больше, чем можно слить за один проход, то, как в
+  // K-ичном коде Хаффмана, на промежуточную ленту каждый раз сливаются
+  // кратчайшие отрезки. Первая группа дополняется до размера, при котором
+  // последний проход сливает ровно merge_fan_in отрезков, поэтому каждая
+  // ячейка переписывается наименьшее возможное количество раз.
+  const size_t fan_in = m_tape_dev.getDevConfig().merge_fan_in;
+  if (fan_in != 0 && temp_tape_idxs.size() > fan_in) {
+    using RunLength = std::pair<size_t, size_t>;
+    std::pmr::vector<RunLength> runs_container(&m_memory_arena);
+    runs_container.reserve(temp_tape_idxs.size());
+    std::priority_queue<RunLength, std::pmr::vector<RunLength>, std::greater<RunLength>> runs(
+        std::greater<RunLength>{}, std::move(runs_container));
+    for (size_t i : temp_tape_idxs) {
+      runs.emplace(m_num_values_on_temp_tapes.at(i), i);
+    }
+
+    size_t group_size = (runs.size() - 2) % (fan_in - 1) + 2;
+    while (runs.size() > fan_in) {
+      temp_tape_idxs.clear();
+      for (size_t k = 0; k < group_size; ++k) {
+        temp_tape_idxs.push_back(runs.top().second);
+        runs.pop();
       }
+
+      const size_t merged_temp_tape_idx = mergeIntoTempTape(temp_tape_idxs);
+      runs.emplace(m_num_values_on_temp_tapes.at(merged_temp_tape_idx), merged_temp_tape_idx);
+      group_size = fan_in;
     }
 
-    std::vector<int> buf_to_sort = m_tape_dev.getMemBufCopy().first;
+    temp_tape_idxs.clear();
+    for (; !runs.empty(); runs.pop()) {
+      temp_tape_idxs.push_back(runs.top().second);
+    }
+    std::sort(temp_tape_idxs.begin(), temp_tape_idxs.end());
+  }
+
+  mergeTempTapes(temp_tape_idxs, m_output_tape_file_path, true);
+}
+
+template <typename T, typename Compare>
+size_t BasicTapeSorter<T, Compare>::mergeIntoTempTape(
+    const std::pmr::vector<size_t>& t_temp_tape_idxs) {
+  makeTempTape();
+  const size_t merged_temp_tape_idx = m_temp_tapes_counter - 1;
 
-    // Удаляем ненужные для нас значения, которые находились в буфере.
-    if (buf_to_sort.size() > m_num_values_on_temp_tapes.at(i)) {
-      buf_to_sort.erase(buf_to_sort.begin() + m_num_values_on_temp_tapes.at(i), buf_to_sort.end());
+  mergeTempTapes(t_temp_tape_idxs, tempTapeFilePath(merged_temp_tape_idx), false);
+
+  size_t merged_run_size = 0;
+  for (size_t i : t_temp_tape_idxs) {
+    merged_run_size += m_num_values_on_temp_tapes.at(i);
+    m_num_values_on_temp_tapes.at(i) = 0;
+  }
+  m_num_values_on_temp_tapes.push_back(merged_run_size);
+
+  if (isCheckpointing()) {
+    for (size_t i : t_temp_tape_idxs) {
+      m_checkpoint.run_sizes.at(i) = 0;
     }
+    m_checkpoint.run_sizes.push_back(merged_run_size);
+    m_checkpoint.runs_sorted.push_back(true);
+    saveCheckpoint();
+  }
 
-    std::sort(buf_to_sort.begin(), buf_to_sort.end());
+  // Слитые ленты больше не нужны, поэтому удаляются сразу, а не после
+  // сортировки.
+  for (size_t i : t_temp_tape_idxs) {
+    const std::filesystem::path temp_tape_file_path = tempTapeFilePath(i);
+    std::filesystem::remove(temp_tape_file_path);
+    std::filesystem::remove(TapeCellIndex::indexFilePath(temp_tape_file_path));
+  }
+
+  return merged_temp_tape_idx;
+}
 
-    m_tape_dev.replaceTape(m_temp_tape_file_paths.at(i), TapeDevOperationMode::Write);
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::mergeTempTapes(const std::pmr::vector<size_t>& t_temp_tape_idxs,
+                                                 const std::filesystem::path& t_output_path,
+                                                 bool t_final) {
+  // По одной считывающей головке на каждую временную ленту. Головки не
+  // переоткрывают файлы и не перематывают ленты на протяжении всего слияния,
+  // поэтому каждая ячейка временной ленты считывается ровно один раз.
+  std::pmr::vector<IBasicTapeDev<T>*> temp_tape_devs(m_temp_tapes_counter, nullptr,
+                                                     &m_memory_arena);
 
-    for (size_t i = 0; i < buf_to_sort.size(); ++i) {
-      try {
-        m_tape_dev.write(buf_to_sort.at(i));
-      } catch (const BadTapeException& e) {
-        throw e;
+  // Количество ещё не обработанных значений на каждой временной ленте.
+  std::pmr::vector<size_t> num_remaining_values(m_temp_tapes_counter, &m_memory_arena);
+
+  // Min-куча из текущих значений под головками временных лент.
+  std::pmr::vector<HeadValue> heads_container(&m_memory_arena);
+  heads_container.reserve(t_temp_tape_idxs.size());
+  std::priority_queue<HeadValue, std::pmr::vector<HeadValue>, HeadValueGreater> heads(
+      HeadValueGreater{m_compare}, std::move(heads_container));
+
+  // Контрольные точки записываются только при слиянии на выходную ленту. При
+  // продолжении слияния головки устанавливаются на первые значения, ещё не
+  // записанные на выходную ленту.
+  const bool checkpointing_flag = t_final && isCheckpointing();
+  const bool resumed_merge_flag = checkpointing_flag && !m_checkpoint.merge_consumed.empty();
+  if (checkpointing_flag) {
+    m_checkpoint.merge_consumed.resize(m_temp_tapes_counter);
+  }
+
+  for (size_t i : t_temp_tape_idxs) {
+    temp_tape_devs.at(i) =
+        &m_tape_dev_pool.acquire(tempTapeFilePath(i), TapeDevOperationMode::Read);
+    const size_t num_consumed_values =
+        resumed_merge_flag ? m_checkpoint.merge_consumed.at(i) : 0;
+    num_remaining_values.at(i) = m_num_values_on_temp_tapes.at(i) - num_consumed_values;
+
+    if (num_remaining_values.at(i) > 0) {
+      if (num_consumed_values > 0) {
+        temp_tape_devs.at(i)->seekToCell(num_consumed_values);
       }
+      heads.emplace(temp_tape_devs.at(i)->read(), i);
+    }
+  }
+
+  // Значения, записанные на выходную ленту после последней контрольной точки,
+  // отбрасываются и записываются заново.
+  if (resumed_merge_flag) {
+    std::filesystem::resize_file(t_output_path, m_checkpoint.merge_output_bytes);
+  }
+
+  // Выходная лента остаётся открытой на протяжении всего слияния.
+  IBasicTapeDev<T>& output_tape_dev = m_tape_dev_pool.acquire(
+      t_output_path,
+      resumed_merge_flag ? TapeDevOperationMode::Append : TapeDevOperationMode::Write);
+
+  const size_t checkpoint_interval = m_tape_dev.getDevConfig().checkpoint_interval;
+  size_t num_values_since_checkpoint = 0;
+
+  while (!heads.empty()) {
+    const auto [min_val, temp_tape_idx] = heads.top();
+    heads.pop();
+
+    output_tape_dev.write(min_val);
+
+    if (checkpointing_flag && ++num_values_since_checkpoint == checkpoint_interval) {
+      // Значение под головкой временной ленты уже записано, но головка ещё не
+      // сдвинута, поэтому оно учитывается как записанное.
+      output_tape_dev.flush();
+      m_checkpoint.merge_output_cells += num_values_since_checkpoint;
+      m_checkpoint.merge_output_bytes = std::filesystem::file_size(t_output_path);
+      for (size_t i : t_temp_tape_idxs) {
+        m_checkpoint.merge_consumed.at(i) =
+            m_num_values_on_temp_tapes.at(i) - num_remaining_values.at(i);
+      }
+      m_checkpoint.merge_consumed.at(temp_tape_idx) += 1;
+      saveCheckpoint();
+      num_values_since_checkpoint = 0;
+    }
+
+    IBasicTapeDev<T>& temp_tape_dev = *temp_tape_devs.at(temp_tape_idx);
+    num_remaining_values.at(temp_tape_idx) -= 1;
+
+    // Сдвигаем головку временной ленты на следующее значение и, если лента
+    // ещё не исчерпана, помещаем его в кучу.
+    if (num_remaining_values.at(temp_tape_idx) > 0) {
+      temp_tape_dev.shiftRight();
+      heads.emplace(temp_tape_dev.read(), temp_tape_idx);
     }
   }
+
+  output_tape_dev.flush();
+  m_tape_dev_pool.releaseAll();
 }
 
-void TapeSorter::backward_pass() {
-  std::vector<int> temp_tapes_indices(m_temp_tapes_counter);
-  size_t temp_tape_idx = 0;
-  int min_val = std::numeric_limits<int>::max();
-  int curr_val = 0;
-  // Количество значений, которое нужно обработать.
-  int t = m_values_counter;
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::polyphase_pass() {
+  // Перематываем ленты, записанные на этапе подготовки: устройства записи
+  // освобождаются, а ленты устанавливаются на чтение.
+  for (IBasicTapeDev<T>* temp_tape_dev : m_polyphase_tape_devs) {
+    temp_tape_dev->flush();
+    m_tape_dev_pool.release(*temp_tape_dev);
+  }
+  m_polyphase_tape_devs.clear();
 
-  while (t > 0) {
-    for (size_t i = 0; i < temp_tapes_indices.size(); ++i) {
-      // Если все значения на данной временной ленте обработаны, то пропускаем
-      // её и приступаем к следующей.
-      if (temp_tapes_indices.at(i) == m_num_values_on_temp_tapes.at(i)) {
-        continue;
+  const size_t num_tapes = m_polyphase_runs.size();
+  std::pmr::vector<size_t>& dummy = m_polyphase_dummy_runs;
+  size_t out_idx = num_tapes - 1;
+
+  std::pmr::vector<IBasicTapeDev<T>*> temp_tape_devs(num_tapes, nullptr, &m_memory_arena);
+  for (size_t i = 0; i < num_tapes; ++i) {
+    if (i != out_idx) {
+      temp_tape_devs.at(i) =
+          &m_tape_dev_pool.acquire(tempTapeFilePath(i), TapeDevOperationMode::Read);
+    }
+  }
+
+  // Количество ещё не обработанных значений текущего отрезка на каждой ленте.
+  std::pmr::vector<size_t> num_remaining_values(num_tapes, &m_memory_arena);
+
+  while (true) {
+    // Фаза длится, пока не опустеет одна из входных лент. Если на каждой
+    // входной ленте остался ровно один отрезок, то фаза последняя.
+    size_t phase_len = std::numeric_limits<size_t>::max();
+    bool last_phase_flag = true;
+    for (size_t i = 0; i < num_tapes; ++i) {
+      if (i != out_idx) {
+        const size_t num_runs = m_polyphase_runs.at(i).size() + dummy.at(i);
+        phase_len = std::min(phase_len, num_runs);
+        last_phase_flag = last_phase_flag && num_runs == 1;
       }
+    }
+
+    if (phase_len == 0) {
+      throw std::runtime_error("нарушено распределение отрезков многофазного слияния.");
+    }
+
+    IBasicTapeDev<T>& output_tape_dev = m_tape_dev_pool.acquire(
+        last_phase_flag ? m_output_tape_file_path : tempTapeFilePath(out_idx),
+        TapeDevOperationMode::Write);
 
-      m_tape_dev.replaceTape(m_temp_tape_file_paths.at(i), TapeDevOperationMode::Read);
+    for (size_t k = 0; k < phase_len; ++k) {
+      std::pmr::vector<HeadValue> heads_container(&m_memory_arena);
+      heads_container.reserve(num_tapes);
+      std::priority_queue<HeadValue, std::pmr::vector<HeadValue>, HeadValueGreater> heads(
+          HeadValueGreater{m_compare}, std::move(heads_container));
+      size_t run_size = 0;
 
-      for (size_t j = 0; j < temp_tapes_indices.at(i) && j < m_num_values_on_temp_tapes.at(i);
-           ++j) {
-        m_tape_dev.shiftRight();
+      // Фиктивные отрезки расположены в начале ленты и расходуются первыми.
+      for (size_t i = 0; i < num_tapes; ++i) {
+        if (i == out_idx) {
+          continue;
+        }
+        if (dummy.at(i) > 0) {
+          dummy.at(i) -= 1;
+          continue;
+        }
+        num_remaining_values.at(i) = m_polyphase_runs.at(i).front();
+        m_polyphase_runs.at(i).pop_front();
+        run_size += num_remaining_values.at(i);
+        heads.emplace(temp_tape_devs.at(i)->read(), i);
       }
 
-      if (m_tape_dev.atEndOfTape()) {
+      // Слияние одних лишь фиктивных отрезков даёт фиктивный отрезок.
+      if (run_size == 0) {
+        dummy.at(out_idx) += 1;
         continue;
       }
 
-      try {
-        curr_val = m_tape_dev.read();
-      } catch (const BadTapeException& e) {
-        throw e;
-      } catch (const EndOfTapeException& e) {
-        throw e;
-      }
+      while (!heads.empty()) {
+        const auto [min_val, temp_tape_idx] = heads.top();
+        heads.pop();
 
-      if (curr_val < min_val) {
-        min_val = curr_val;
-        temp_tape_idx = i;
+        output_tape_dev.write(min_val);
+
+        IBasicTapeDev<T>& temp_tape_dev = *temp_tape_devs.at(temp_tape_idx);
+        num_remaining_values.at(temp_tape_idx) -= 1;
+
+        // Головка сдвигается, пока на ленте остаются значения текущего или
+        // следующих отрезков.
+        if (num_remaining_values.at(temp_tape_idx) > 0 ||
+            !m_polyphase_runs.at(temp_tape_idx).empty()) {
+          temp_tape_dev.shiftRight();
+        }
+        if (num_remaining_values.at(temp_tape_idx) > 0) {
+          heads.emplace(temp_tape_dev.read(), temp_tape_idx);
+        }
       }
+
+      m_polyphase_runs.at(out_idx).push_back(run_size);
     }
 
-    m_tape_dev.replaceTape(m_output_tape_file_path, TapeDevOperationMode::Append);
+    output_tape_dev.flush();
+    m_tape_dev_pool.release(output_tape_dev);
 
-    try {
-      m_tape_dev.write(min_val);
-    } catch (const BadTapeException& e) {
-      throw e;
+    if (last_phase_flag) {
+      break;
     }
-    t -= 1;
-    temp_tapes_indices.at(temp_tape_idx) += 1;
-    min_val = std::numeric_limits<int>::max();
+
+    // Опустевшая входная лента становится выходной лентой следующей фазы, а
+    // выходная лента текущей фазы перематывается и становится входной.
+    size_t next_out_idx = out_idx;
+    for (size_t i = 0; i < num_tapes; ++i) {
+      if (i != out_idx && m_polyphase_runs.at(i).empty() && dummy.at(i) == 0) {
+        next_out_idx = i;
+        break;
+      }
+    }
+
+    if (next_out_idx == out_idx) {
+      throw std::runtime_error("нарушено распределение отрезков многофазного слияния.");
+    }
+
+    m_tape_dev_pool.release(*temp_tape_devs.at(next_out_idx));
+    temp_tape_devs.at(next_out_idx) = nullptr;
+    temp_tape_devs.at(out_idx) =
+        &m_tape_dev_pool.acquire(tempTapeFilePath(out_idx), TapeDevOperationMode::Read);
+    out_idx = next_out_idx;
   }
+
+  m_tape_dev_pool.releaseAll();
+}
+
+template <typename T, typename Compare>
+size_t BasicTapeSorter<T, Compare>::getNumRuns() const noexcept {
+  return m_runs_counter;
 }
 
-void TapeSorter::doAfterSortCleanup() noexcept {
-  for (size_t i = 0; i < m_temp_tape_file_paths.size(); ++i) {
-    std::filesystem::remove(m_temp_tape_file_paths.at(i));
+template <typename T, typename Compare>
+TapeDevStats& BasicTapeSorter<T, Compare>::getTapeDevStats() noexcept {
+  return m_tape_dev_pool.getStats();
+}
+
+template <typename T, typename Compare>
+uint64_t BasicTapeSorter<T, Compare>::getEmulatedTimeMs() const noexcept {
+  return m_emulated_time_ms;
+}
+
+template <typename T, typename Compare>
+size_t BasicTapeSorter<T, Compare>::getPeakMemoryUsage() const noexcept {
+  return m_memory_arena.getPeakBytes();
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::doAfterSortCleanup() noexcept {
+  m_tape_dev_pool.releaseAll();
+
+  for (size_t i = 0; i < m_temp_tapes_counter; ++i) {
+    const std::filesystem::path temp_tape_file_path = tempTapeFilePath(i);
+    std::filesystem::remove(temp_tape_file_path);
+    std::filesystem::remove(TapeCellIndex::indexFilePath(temp_tape_file_path));
   }
+
+  // Сортировка завершена, поэтому контрольная точка больше не нужна.
+  std::error_code ec;
+  const std::filesystem::path manifest_path = SortCheckpoint::manifestPath(m_data_dir_path);
+  std::filesystem::remove(manifest_path, ec);
+  std::filesystem::path new_manifest_path = manifest_path;
+  new_manifest_path += ".new";
+  std::filesystem::remove(new_manifest_path, ec);
 }
 
-void TapeSorter::makeTempTape() {
-  std::filesystem::path new_temp_tape_file_path = m_data_dir_path;
+template <typename T, typename Compare>
+std::filesystem::path BasicTapeSorter<T, Compare>::tempTapeFilePath(
+    size_t t_temp_tape_idx) const {
+  std::filesystem::path temp_tape_file_path = m_data_dir_path;
 
-  new_temp_tape_file_path.append("var").append("tmp").append(
-      "temp_tape_" + std::to_string(m_temp_tapes_counter) + ".txt");
+  const std::string extension =
+      m_tape_dev.getDevConfig().temp_tape_format == TapeFileFormat::Binary
+          ? kBinaryTapeFileExtension
+          : ".txt";
 
-  m_temp_tape_file_paths.push_back(new_temp_tape_file_path);
+  temp_tape_file_path.append("var").append("tmp").append(
+      "temp_tape_" + std::to_string(t_temp_tape_idx) + extension);
+
+  return temp_tape_file_path;
+}
+
+template <typename T, typename Compare>
+std::filesystem::path BasicTapeSorter<T, Compare>::sortedTempTapeFilePath(
+    size_t t_temp_tape_idx) const {
+  const std::filesystem::path temp_tape_file_path = tempTapeFilePath(t_temp_tape_idx);
+
+  std::filesystem::path sorted_temp_tape_file_path = temp_tape_file_path;
+  sorted_temp_tape_file_path.replace_filename(temp_tape_file_path.stem().string() + "_sorted" +
+                                              temp_tape_file_path.extension().string());
+
+  return sorted_temp_tape_file_path;
+}
+
+template <typename T, typename Compare>
+void BasicTapeSorter<T, Compare>::makeTempTape() {
+  const std::filesystem::path new_temp_tape_file_path = tempTapeFilePath(m_temp_tapes_counter);
 
   m_temp_tapes_counter += 1;
 
@@ -284,4 +1208,11 @@ void TapeSorter::makeTempTape() {
   temp_tape_file.close();
 }
 
-TapeSorter::~TapeSorter() {}
\ No newline at end of file
+template <typename T, typename Compare>
+BasicTapeSorter<T, Compare>::~BasicTapeSorter() {}
+
+template class BasicTapeSorter<std::int32_t>;
+template class BasicTapeSorter<std::int32_t, std::greater<std::int32_t>>;
+template class BasicTapeSorter<std::int64_t>;
+template class BasicTapeSorter<std::uint64_t>;
+template class BasicTapeSorter<TapeRecord>;
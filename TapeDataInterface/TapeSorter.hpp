@@ -1,38 +1,272 @@
 #ifndef TAPE_SORTER_HPP
 #define TAPE_SORTER_HPP
 
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
+#include "MemoryArena.hpp"
+#include "RunSort.hpp"
+#include "SortCheckpoint.hpp"
 #include "TapeDev.hpp"
+#include "TapeDevPool.hpp"
 
-class TapeSorter final {
+/*
+ * Шаблон BasicTapeSorter
+ *
+ * Сортировщик ленты с ячейками типа T в порядке, заданном компаратором
+ * Compare. Шаблон явно инстанцирован для типов ячеек std::int32_t,
+ * std::int64_t, std::uint64_t и TapeRecord с компаратором std::less, а также
+ * для std::int32_t с компаратором std::greater (сортировка по убыванию).
+ * Сортировщик ячеек типа 'int' по возрастанию доступен под именем TapeSorter.
+ */
+template <typename T, typename Compare = std::less<T>>
+class BasicTapeSorter final {
  public:
-  TapeSorter(TapeDev&, const std::filesystem::path&, const std::filesystem::path&,
-             const std::filesystem::path&) noexcept;
+  /// Создаёт сортировщик, который использует собственный пул устройств с
+  /// конфигурацией переданного основного устройства.
+  BasicTapeSorter(BasicTapeDev<T>&, const std::filesystem::path&, const std::filesystem::path&,
+                  const std::filesystem::path&, const Compare& = Compare()) noexcept;
+
+  /// Создаёт сортировщик, который использует переданный пул устройств для
+  /// работы с входной, временными и выходной лентами. Буфер памяти основного
+  /// устройства используется как рабочая память сортировщика.
+  BasicTapeSorter(BasicTapeDev<T>&, BasicTapeDevPool<T>&, const std::filesystem::path&,
+                  const std::filesystem::path&, const std::filesystem::path&,
+                  const Compare& = Compare()) noexcept;
 
   // FIXME: добавить документирующие комментарии.
   void sort();
 
-  ~TapeSorter();
+  /// Продолжает сортировку, прерванную после записи контрольной точки (см.
+  /// TapeDevConfig::checkpoint_interval): завершённые отрезки не
+  /// формируются заново, формирование отрезков продолжается с первой ячейки
+  /// входной ленты, не вошедшей в них, а слияние - с последней записанной
+  /// на выходную ленту ячейки. Если контрольные точки отключены,
+  /// контрольной точки нет, её манифест повреждён или она записана при
+  /// сортировке других лент, выполняет сортировку заново, как sort().
+  /// Возвращает true, если сортировка продолжена с контрольной точки.
+  bool resume();
+
+  /// Возвращает количество отсортированных отрезков, полученных при последней
+  /// сортировке.
+  size_t getNumRuns() const noexcept;
+
+  /// Возвращает статистику операций с лентами, накопленную пулом устройств
+  /// при последней сортировке. Статистика собирается, если в пуле включён
+  /// сбор статистики (см. TapeDevPool::setStatsEnabled()).
+  TapeDevStats& getTapeDevStats() noexcept;
+
+  /// Возвращает время, на которое при последней сортировке продвинулись
+  /// виртуальные часы устройств (см. TapeDevConfig::virtual_clock), мс. Если
+  /// виртуальные часы не заданы, возвращает 0.
+  uint64_t getEmulatedTimeMs() const noexcept;
+
+  /// Возвращает пиковый объём рабочей памяти сортировщика при последней
+  /// сортировке в байтах: буфер памяти основного устройства и все
+  /// контейнеры, выделенные из арены рабочей памяти (см.
+  /// TapeDevConfig::memory_limit).
+  size_t getPeakMemoryUsage() const noexcept;
+
+  ~BasicTapeSorter();
 
  private:
+  /// Размер в байтах промежуточного буфера, через который при выборе с
+  /// замещением считывается входная лента. Буфер невелик по сравнению с
+  /// буфером памяти, поэтому выбор с замещением использует почти столько же
+  /// рабочей памяти, сколько разбиение на части.
+  static constexpr size_t kInputStagingBufBytes = 4 * 1024;
+
+  /// Значение под головкой временной ленты при слиянии: пара (значение,
+  /// индекс временной ленты).
+  using HeadValue = std::pair<T, size_t>;
+
+  /// Упорядочивает значения под головками для кучи слияния: на вершине кучи
+  /// находится наименьшее в порядке Compare значение, а из равных - значение
+  /// с ленты с меньшим индексом.
+  struct HeadValueGreater {
+    Compare compare;
+
+    bool operator()(const HeadValue& t_lhs, const HeadValue& t_rhs) const {
+      if (compare(t_rhs.first, t_lhs.first)) {
+        return true;
+      }
+      if (compare(t_lhs.first, t_rhs.first)) {
+        return false;
+      }
+      return t_lhs.second > t_rhs.second;
+    }
+  };
+
+  /// Выполняет сортировку заново или, если передан флаг, продолжает её с
+  /// контрольной точки. Возвращает true, если сортировка продолжена с
+  /// контрольной точки.
+  bool sortImpl(bool);
+
   // FIXME: добавить документирующие комментарии.
   void setup();
 
-  // FIXME: добавить документирующие комментарии.
+  /// Заполняет буфер памяти основного устройства блоком значений с текущей
+  /// позиции головки переданного устройства, пока буфер не заполнится или не
+  /// будет достигнут конец ленты. Возвращает количество считанных значений.
+  size_t loadMemBufFromTape(IBasicTapeDev<T>&);
+
+  /// Разбивает входную ленту на отрезки, равные размеру буфера памяти
+  /// устройства, и выгружает их без сортировки на временные ленты. Второй
+  /// аргумент - количество значений, уже считанных в буфер памяти.
+  void generateChunkRuns(IBasicTapeDev<T>&, size_t);
+
+  /// Формирует отсортированные отрезки методом выбора с замещением, используя
+  /// буфер памяти устройства как min-кучу. На случайных данных средняя длина
+  /// отрезка вдвое больше размера буфера памяти, а почти отсортированная
+  /// входная лента превращается в единственный отрезок. Второй аргумент -
+  /// количество значений, уже считанных в буфер памяти.
+  void generateRunsByReplacementSelection(IBasicTapeDev<T>&, size_t);
+
+  /// Разбивает входную ленту на отрезки размером с половину буфера памяти
+  /// устройства. Пока одна половина буфера сортируется и записывается на
+  /// временную ленту, другая заполняется с входной ленты в отдельном потоке,
+  /// поэтому задержки чтения и записи перекрываются. Второй аргумент -
+  /// количество значений, уже считанных в буфер памяти.
+  void generatePipelinedChunkRuns(IBasicTapeDev<T>&, size_t);
+
+  /// Формирует отрезки из естественных отрезков входной ленты - участков,
+  /// значения которых уже упорядочены. Входная лента читается блоками
+  /// размером с буфер памяти устройства. Упорядоченный блок дописывается к
+  /// текущему отрезку, если продолжает его, иначе начинает новый отрезок.
+  /// Блок из двух упорядоченных частей, первая из которых продолжает текущий
+  /// отрезок, делится между текущим и новым отрезками, а остальные блоки
+  /// упорядочиваются sortPresortedBlock().
+  /// Поэтому уже отсортированная входная лента даёт единственный отрезок, а
+  /// лента из нескольких длинных упорядоченных участков - по отрезку на
+  /// участок. Второй аргумент - количество значений, уже считанных в буфер
+  /// памяти.
+  void generateNaturalRuns(IBasicTapeDev<T>&, size_t);
+
+  /// Упорядочивает переданный блок значений: уже упорядоченный блок не
+  /// изменяется, строго убывающий в порядке Compare блок обращается, а
+  /// остальные блоки сортируются sortRun().
+  void sortPresortedBlock(T*, size_t);
+
+  /// Сортирует переданный блок значений и записывает его как новый отрезок.
+  void spillSortedRun(T*, size_t);
+
+  /// Начинает новый отрезок и возвращает устройство, на которое его следует
+  /// записать. При K-путевом слиянии для отрезка создаётся новая временная
+  /// лента, при многофазном - выбирается одна из лент по распределению
+  /// Фибоначчи.
+  IBasicTapeDev<T>& beginRun();
+
+  /// Завершает отрезок, записанный на переданное устройство. Второй аргумент -
+  /// количество значений в отрезке, третий показывает, что отрезок уже
+  /// отсортирован.
+  void endRun(IBasicTapeDev<T>&, size_t, bool);
+
+  /// Показывает, что сортировка выполняется многофазным слиянием.
+  bool isPolyphase() const noexcept;
+
+  /// Показывает, что сортировщик записывает контрольные точки. Контрольные
+  /// точки записываются только при K-путевом слиянии: при многофазном
+  /// слиянии на одной временной ленте хранится несколько отрезков.
+  bool isCheckpointing() const noexcept;
+
+  /// Сбрасывает состояние предыдущей сортировки (счётчики отрезков и
+  /// временных лент, флаги, распределение многофазного слияния), чтобы
+  /// сортировщик можно было запускать повторно.
+  void resetSortState();
+
+  /// Заполняет описание сортировки в контрольной точке (пути и размер
+  /// входной ленты, тип ячеек и т. д.) и очищает её состояние.
+  void initCheckpoint();
+
+  /// Восстанавливает состояние сортировщика из переданной контрольной точки.
+  void restoreFromCheckpoint(const SortCheckpoint&);
+
+  /// Записывает контрольную точку в манифест, если контрольные точки
+  /// включены.
+  void saveCheckpoint() const;
+
+  /// Создаёт временные ленты многофазного слияния и устанавливает на запись
+  /// все ленты, кроме последней, которая становится выходной лентой первой
+  /// фазы.
+  void setupPolyphaseTapes();
+
+  /// Выбирает ленту для очередного отрезка по алгоритму горизонтального
+  /// распределения (Кнут, т. 3, алгоритм 5.4.2D) и возвращает её индекс.
+  /// Недостающие до совершенного распределения Фибоначчи отрезки учитываются
+  /// как фиктивные.
+  size_t selectPolyphaseTape() noexcept;
+
+  /// Сортирует отрезки всех временных лент. Отрезки независимы, поэтому
+  /// сортируются параллельно TapeDevConfig::sort_workers_count потоками, каждый
+  /// из которых работает с лентой на собственном устройстве пула. Результат
+  /// не зависит от количества потоков.
   void forward_pass();
 
-  // FIXME: добавить документирующие комментарии.
+  /// Считывает отрезок временной ленты с переданным индексом в переданный
+  /// буфер, сортирует его и записывает обратно на ту же ленту. Третий
+  /// аргумент - вспомогательный буфер поразрядной сортировки потока.
+  void sortTempTape(size_t, T*, RunSortScratch<T>&);
+
+  /// Выполняет K-путевое слияние отсортированных временных лент на выходную
+  /// ленту. Если временных лент больше TapeDevConfig::merge_fan_in, то
+  /// кратчайшие отрезки предварительно сливаются на промежуточные временные
+  /// ленты так, чтобы общее количество переписанных ячеек было наименьшим.
   void backward_pass();
 
+  /// Сливает временные ленты с переданными индексами на новую временную
+  /// ленту и удаляет их. Возвращает индекс новой временной ленты.
+  size_t mergeIntoTempTape(const std::pmr::vector<size_t>&);
+
+  /// Выполняет K-путевое слияние временных лент с переданными индексами на
+  /// ленту по переданному пути. Каждая временная лента читается собственной
+  /// головкой, текущие значения головок хранятся в min-куче, а выходная
+  /// лента остаётся открытой на протяжении всего слияния. Каждая ячейка
+  /// считывается и записывается ровно один раз. Флаг показывает, что
+  /// слияние записывает выходную ленту сортировки: только такое слияние
+  /// записывает контрольные точки и может быть продолжено с них.
+  void mergeTempTapes(const std::pmr::vector<size_t>&, const std::filesystem::path&, bool);
+
+  /// Выполняет многофазное слияние отрезков, распределённых по временным
+  /// лентам на этапе подготовки. В каждой фазе отрезки со всех лент, кроме
+  /// одной, сливаются на оставшуюся ленту, пока одна из входных лент не
+  /// опустеет. Опустевшая лента становится выходной лентой следующей фазы, а
+  /// выходная перематывается и становится входной. Последняя фаза пишет
+  /// результат сразу на выходную ленту.
+  void polyphase_pass();
+
   void doAfterSortCleanup() noexcept;
 
   // FIXME: добавить документирующие комментарии.
   void makeTempTape();
 
-  // FIXME: добавить документирующие комментарии.
-  TapeDev& m_tape_dev;
+  /// Возвращает путь к файлу временной ленты с переданным индексом. Пути не
+  /// хранятся, а вычисляются по индексу, чтобы не занимать рабочую память.
+  std::filesystem::path tempTapeFilePath(size_t) const;
+
+  /// Возвращает путь к файлу, в который записывается отсортированный отрезок
+  /// временной ленты с переданным индексом, если контрольные точки включены.
+  /// После записи файл заменяет временную ленту, поэтому сбой во время
+  /// записи не повреждает отрезок.
+  std::filesystem::path sortedTempTapeFilePath(size_t) const;
+
+  /// Основное устройство. Его буфер памяти является рабочей памятью
+  /// сортировщика.
+  BasicTapeDev<T>& m_tape_dev;
+
+  /// Пул устройств, созданный сортировщиком, если пул не был передан в
+  /// конструктор.
+  std::unique_ptr<BasicTapeDevPool<T>> m_own_tape_dev_pool;
+
+  /// Пул устройств для работы с входной, временными и выходной лентами.
+  BasicTapeDevPool<T>& m_tape_dev_pool;
+
+  /// Компаратор, задающий порядок сортировки.
+  const Compare m_compare;
 
   // FIXME: добавить документирующие комментарии.
   const std::filesystem::path m_target_tape_file_path;
@@ -43,23 +277,65 @@ class TapeSorter final {
   // FIXME: добавить документирующие комментарии.
   const std::filesystem::path m_data_dir_path;
 
-  // FIXME: добавить документирующие комментарии.
-  std::vector<std::string> m_temp_tape_file_paths;
+  /// Арена, из которой выделяется рабочая память сортировщика. Её ёмкость
+  /// задаётся полем TapeDevConfig::memory_limit.
+  MemoryArena m_memory_arena;
 
   /// Показывает, что на стадии setup все элементы входной ленты получилось
   /// прочитать в память устройства. Следовательно, можно сразу произвести
   /// их соритровку и запись на выходную ленту.
   bool m_shortcut_flag;
 
+  /// Показывает, что отрезки на временных лентах уже отсортированы и этап
+  /// TapeSorter::forward_pass() не требуется.
+  bool m_runs_sorted_flag;
+
   /// Вектор, который хранит количество значений, содержащихся на каждой временной
   /// ленте после выполнения TapeSorter::setup().
-  std::vector<int> m_num_values_on_temp_tapes;
+  std::pmr::vector<int> m_num_values_on_temp_tapes;
 
   // FIXME: добавить документирующие комментарии.
   size_t m_temp_tapes_counter;
 
   // FIXME: добавить документирующие комментарии.
   size_t m_values_counter;
+
+  /// Количество отрезков, сформированных на этапе подготовки.
+  size_t m_runs_counter;
+
+  /// Вспомогательный буфер поразрядной сортировки отрезков, которые
+  /// сортируются в вызывающем потоке (см. TapeDevConfig::run_sort_kernel).
+  RunSortScratch<T> m_run_sort_scratch;
+
+  /// Текущая контрольная точка сортировки. Обновляется по мере формирования,
+  /// сортировки и слияния отрезков.
+  SortCheckpoint m_checkpoint;
+
+  /// Время, на которое продвинулись виртуальные часы устройств при последней
+  /// сортировке, мс.
+  uint64_t m_emulated_time_ms;
+
+  /// Устройства, на которые записываются отрезки на этапе подготовки при
+  /// многофазном слиянии. Индекс устройства совпадает с индексом временной
+  /// ленты.
+  std::pmr::vector<IBasicTapeDev<T>*> m_polyphase_tape_devs;
+
+  /// Длины реальных отрезков на каждой ленте многофазного слияния в порядке
+  /// их расположения на ленте.
+  std::pmr::vector<std::pmr::deque<size_t>> m_polyphase_runs;
+
+  /// Количество фиктивных отрезков на каждой ленте многофазного слияния.
+  /// Фиктивные отрезки считаются расположенными в начале ленты.
+  std::pmr::vector<size_t> m_polyphase_dummy_runs;
+
+  /// Количество отрезков на каждой ленте в совершенном распределении текущего
+  /// уровня.
+  std::pmr::vector<size_t> m_polyphase_perfect_runs;
+
+  /// Индекс ленты, на которую записывается текущий отрезок.
+  size_t m_polyphase_tape_idx;
 };
 
+using TapeSorter = BasicTapeSorter<int>;
+
 #endif  // TAPE_SORTER_HPP
\ No newline at end of file
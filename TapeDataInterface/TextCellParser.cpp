@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TEXT_CELL_PARSER_X86 1
+#include <immintrin.h>
+#endif
+
+#include "TapeDevExceptions.hpp"
+#include "TextCellParser.hpp"
+
+namespace {
+
+/// Количество символов, которые классифицируются за один вызов.
+constexpr size_t kClassifyBlockSize = 64;
+
+/// Классифицирует 64 символа: в i-м бите первой маски устанавливается
+/// признак цифры, второй - знака минус, третьей - пробельного символа (как у
+/// std::isspace в локали "C").
+using ClassifyBlockFn = void (*)(const char*, uint64_t&, uint64_t&, uint64_t&);
+
+void classifyBlockScalar(const char* t_block, uint64_t& t_digits, uint64_t& t_minuses,
+                         uint64_t& t_spaces) {
+  uint64_t digits = 0;
+  uint64_t minuses = 0;
+  uint64_t spaces = 0;
+  for (size_t i = 0; i < kClassifyBlockSize; ++i) {
+    const auto ch = static_cast<unsigned char>(t_block[i]);
+    digits |= static_cast<uint64_t>(static_cast<unsigned char>(ch - '0') < 10) << i;
+    minuses |= static_cast<uint64_t>(ch == '-') << i;
+    spaces |= static_cast<uint64_t>(ch == ' ' || static_cast<unsigned char>(ch - '\t') < 5) << i;
+  }
+  t_digits = digits;
+  t_minuses = minuses;
+  t_spaces = spaces;
+}
+
+#ifdef TEXT_CELL_PARSER_X86
+
+/// Классы символов задаются диапазонами для инструкции PCMPESTRM: цифры
+/// '0'-'9', пробельные символы '\t'-'\r' и ' '. Знак минус сравнивается
+/// побайтово.
+__attribute__((target("sse4.2"))) void classifyBlockSse42(const char* t_block,
+                                                          uint64_t& t_digits,
+                                                          uint64_t& t_minuses,
+                                                          uint64_t& t_spaces) {
+  const __m128i digit_ranges = _mm_setr_epi8('0', '9', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i space_ranges =
+      _mm_setr_epi8('\t', '\r', ' ', ' ', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i minus_char = _mm_set1_epi8('-');
+  constexpr int kMode = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_BIT_MASK;
+
+  uint64_t digits = 0;
+  uint64_t minuses = 0;
+  uint64_t spaces = 0;
+  for (size_t i = 0; i < kClassifyBlockSize; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_block + i));
+    const auto digit_mask = static_cast<uint16_t>(
+        _mm_cvtsi128_si32(_mm_cmpestrm(digit_ranges, 2, chars, 16, kMode)));
+    const auto minus_mask =
+        static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, minus_char)));
+    const auto space_mask = static_cast<uint16_t>(
+        _mm_cvtsi128_si32(_mm_cmpestrm(space_ranges, 4, chars, 16, kMode)));
+    digits |= static_cast<uint64_t>(digit_mask) << i;
+    minuses |= static_cast<uint64_t>(minus_mask) << i;
+    spaces |= static_cast<uint64_t>(space_mask) << i;
+  }
+  t_digits = digits;
+  t_minuses = minuses;
+  t_spaces = spaces;
+}
+
+__attribute__((target("avx2"))) void classifyBlockAvx2(const char* t_block, uint64_t& t_digits,
+                                                      uint64_t& t_minuses, uint64_t& t_spaces) {
+  const __m256i zero_char = _mm256_set1_epi8('0');
+  const __m256i minus_char = _mm256_set1_epi8('-');
+  const __m256i nine = _mm256_set1_epi8(9);
+  const __m256i tab_char = _mm256_set1_epi8('\t');
+  const __m256i four = _mm256_set1_epi8(4);
+  const __m256i space_char = _mm256_set1_epi8(' ');
+
+  uint64_t digits = 0;
+  uint64_t minuses = 0;
+  uint64_t spaces = 0;
+  for (size_t i = 0; i < kClassifyBlockSize; i += 32) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_block + i));
+
+    // Беззнаковое сравнение x <= n выполняется как min(x, n) == x.
+    const __m256i digit_offsets = _mm256_sub_epi8(chars, zero_char);
+    const __m256i is_digit =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(digit_offsets, nine), digit_offsets);
+    const __m256i is_minus = _mm256_cmpeq_epi8(chars, minus_char);
+    const __m256i control_offsets = _mm256_sub_epi8(chars, tab_char);
+    const __m256i is_space =
+        _mm256_or_si256(_mm256_cmpeq_epi8(chars, space_char),
+                        _mm256_cmpeq_epi8(_mm256_min_epu8(control_offsets, four), control_offsets));
+
+    digits |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(is_digit))) << i;
+    minuses |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(is_minus))) << i;
+    spaces |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(is_space))) << i;
+  }
+  t_digits = digits;
+  t_minuses = minuses;
+  t_spaces = spaces;
+}
+
+#endif  // TEXT_CELL_PARSER_X86
+
+ClassifyBlockFn classifyBlockFn(TextCellParserIsa t_isa) noexcept {
+#ifdef TEXT_CELL_PARSER_X86
+  switch (t_isa) {
+    case TextCellParserIsa::Avx2:
+      return classifyBlockAvx2;
+    case TextCellParserIsa::Sse42:
+      return classifyBlockSse42;
+    default:
+      break;
+  }
+#else
+  (void)t_isa;
+#endif
+  return classifyBlockScalar;
+}
+
+inline size_t countTrailingZeros(uint64_t t_value) noexcept {
+  return static_cast<size_t>(__builtin_ctzll(t_value));
+}
+
+[[noreturn]] void throwOutOfRange() {
+  throw BadTapeException(
+      "Не удалось выполнить преобразование значения с ленты в целое цисло: значение выходит за "
+      "границы типа 'int'.");
+}
+
+/// Преобразует в число 8 цифр, записанных в байтах переданного числа в
+/// порядке little-endian (SWAR: по два, четыре и восемь разрядов за шаг).
+/// Байты, обнулённые вместо ведущих символов, считаются цифрами '0'.
+inline uint64_t parse8DigitsSwar(uint64_t t_chunk) noexcept {
+  t_chunk = (t_chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+  t_chunk = (t_chunk & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+  t_chunk = (t_chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32;
+  return t_chunk;
+}
+
+/// Преобразует в число от 1 до 8 цифр, оканчивающихся перед t_digits_end.
+/// Аргументы: начало блока символов, конец последовательности цифр и
+/// количество цифр. Если перед цифрами в блоке есть не менее 8 символов, то
+/// они считываются одной загрузкой, а лишние младшие байты обнуляются.
+inline uint64_t parseUpTo8Digits(const char* t_data, const char* t_digits_end,
+                                 size_t t_len) noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  uint64_t chunk;
+  if (t_digits_end - t_data >= 8) {
+    std::memcpy(&chunk, t_digits_end - 8, 8);
+    chunk &= ~uint64_t(0) << (8 * (8 - t_len));
+  } else {
+    chunk = 0;
+    std::memcpy(reinterpret_cast<char*>(&chunk) + (8 - t_len), t_digits_end - t_len, t_len);
+  }
+  return parse8DigitsSwar(chunk);
+#else
+  (void)t_data;
+  uint64_t value = 0;
+  for (const char* ch = t_digits_end - t_len; ch != t_digits_end; ++ch) {
+    value = value * 10 + static_cast<uint64_t>(*ch - '0');
+  }
+  return value;
+#endif
+}
+
+/// Преобразует в число непустую последовательность цифр [t_begin, t_end)
+/// блока, начинающегося с t_data. Значение не должно превышать t_max_value.
+inline uint64_t parseDigits(const char* t_data, const char* t_begin, const char* t_end,
+                            uint64_t t_max_value) {
+  size_t len = static_cast<size_t>(t_end - t_begin);
+  if (len <= 8) {
+    return parseUpTo8Digits(t_data, t_end, len);
+  }
+
+  // Ведущие нули не влияют на значение.
+  while (len > 8 && *t_begin == '0') {
+    ++t_begin;
+    --len;
+  }
+  if (len <= 8) {
+    return parseUpTo8Digits(t_data, t_end, len);
+  }
+
+  // Значение типа 'int' содержит не более 10 цифр.
+  if (len > 10) {
+    throwOutOfRange();
+  }
+
+  uint64_t value = 0;
+  for (; t_begin != t_end - 8; ++t_begin) {
+    value = value * 10 + static_cast<uint64_t>(*t_begin - '0');
+  }
+  value = value * 100000000ULL + parseUpTo8Digits(t_data, t_end, 8);
+  if (value > t_max_value) {
+    throwOutOfRange();
+  }
+  return value;
+}
+
+/// Преобразует в число значение [t_begin, t_end) блока, начинающегося с
+/// t_data: последовательность цифр, перед которой может стоять знак минус.
+inline int parseValue(const char* t_data, const char* t_begin, const char* t_end) {
+  constexpr auto kMaxValue = static_cast<uint64_t>(std::numeric_limits<int>::max());
+  if (*t_begin != '-') {
+    return static_cast<int>(parseDigits(t_data, t_begin, t_end, kMaxValue));
+  }
+
+  if (t_begin + 1 == t_end) {
+    throw BadTapeException("Недопустимый символ на ленте: '-'.");
+  }
+  // Модуль отрицательного значения может быть на единицу больше
+  // максимального значения типа 'int'.
+  const uint64_t abs_value = parseDigits(t_data, t_begin + 1, t_end, kMaxValue + 1);
+  return static_cast<int>(-static_cast<int64_t>(abs_value));
+}
+
+TextCellsParseResult parseTextCellsImpl(ClassifyBlockFn t_classify, const char* t_data,
+                                        size_t t_size, int* t_buf, size_t t_count,
+                                        bool t_last_chunk, size_t* t_cell_offsets) {
+  TextCellsParseResult res;
+  if (t_count == 0) {
+    return res;
+  }
+
+  // Показывает, что последний символ предыдущего блока - цифра или знак
+  // минус, то есть значение, начатое в одном из предыдущих блоков,
+  // продолжается.
+  bool in_value = false;
+  size_t value_start = 0;
+
+  auto emitValue = [&](size_t t_value_end) {
+    if (t_cell_offsets != nullptr) {
+      t_cell_offsets[res.num_values] = value_start;
+    }
+    t_buf[res.num_values++] =
+        parseValue(t_data, t_data + value_start, t_data + t_value_end);
+  };
+
+  char tail[kClassifyBlockSize];
+  for (size_t base = 0; base < t_size; base += kClassifyBlockSize) {
+    const size_t block_size = std::min(kClassifyBlockSize, t_size - base);
+    const char* block = t_data + base;
+    if (block_size < kClassifyBlockSize) {
+      // Неполный блок дополняется пробелами, которые не попадают в маску
+      // допустимых символов блока.
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, block, block_size);
+      block = tail;
+    }
+
+    uint64_t digits = 0;
+    uint64_t minuses = 0;
+    uint64_t spaces = 0;
+    t_classify(block, digits, minuses, spaces);
+
+    const uint64_t valid =
+        block_size == kClassifyBlockSize ? ~uint64_t(0) : (uint64_t(1) << block_size) - 1;
+    // Символы значений: цифры и знаки минус.
+    const uint64_t values = (digits | minuses) & valid;
+    spaces &= valid;
+
+    const uint64_t prev_values = (values << 1) | static_cast<uint64_t>(in_value);
+    // Знак минус допустим только в начале значения. Знак минус без цифр
+    // после него обнаруживается при преобразовании значения.
+    const uint64_t invalid = (~(values | spaces) | (minuses & prev_values)) & valid;
+    const size_t first_invalid = invalid != 0 ? countTrailingZeros(invalid) : kClassifyBlockSize;
+
+    uint64_t value_starts = values & ~prev_values;
+    // Позиции пробельных символов, которые завершают значения.
+    uint64_t value_ends = spaces & prev_values;
+
+    while (value_ends != 0) {
+      const size_t end = countTrailingZeros(value_ends);
+      if (end > first_invalid) {
+        break;
+      }
+      // Начала и окончания значений чередуются, поэтому младшее начало,
+      // предшествующее окончанию, относится к этому значению. Если такого
+      // нет, значение начато в одном из предыдущих блоков.
+      if (value_starts != 0 && countTrailingZeros(value_starts) < end) {
+        value_start = base + countTrailingZeros(value_starts);
+        value_starts &= value_starts - 1;
+      }
+      emitValue(base + end);
+      if (res.num_values == t_count) {
+        res.num_chars = base + end;
+        return res;
+      }
+      value_ends &= value_ends - 1;
+    }
+
+    if (invalid != 0) {
+      throw BadTapeException("Недопустимый символ на ленте: '" +
+                             std::string(1, t_data[base + first_invalid]) + "'.");
+    }
+
+    if (value_starts != 0) {
+      value_start = base + countTrailingZeros(value_starts);
+    }
+    in_value = (values >> (block_size - 1)) & 1;
+  }
+
+  if (in_value) {
+    if (!t_last_chunk) {
+      res.num_chars = value_start;
+      return res;
+    }
+    emitValue(t_size);
+  }
+
+  res.num_chars = t_size;
+  return res;
+}
+
+}  // namespace
+
+TextCellsParseResult parseTextCells(const char* t_data, size_t t_size, int* t_buf,
+                                    size_t t_count, bool t_last_chunk, size_t* t_cell_offsets) {
+  static const ClassifyBlockFn classify = classifyBlockFn(getTextCellParserIsa());
+  return parseTextCellsImpl(classify, t_data, t_size, t_buf, t_count, t_last_chunk,
+                            t_cell_offsets);
+}
+
+TextCellsParseResult parseTextCells(TextCellParserIsa t_isa, const char* t_data, size_t t_size,
+                                    int* t_buf, size_t t_count, bool t_last_chunk,
+                                    size_t* t_cell_offsets) {
+  if (!isTextCellParserIsaSupported(t_isa)) {
+    throw std::invalid_argument(std::string("Реализация разбора ячеек '") +
+                                textCellParserIsaName(t_isa) +
+                                "' не поддерживается процессором.");
+  }
+  return parseTextCellsImpl(classifyBlockFn(t_isa), t_data, t_size, t_buf, t_count, t_last_chunk,
+                            t_cell_offsets);
+}
+
+bool isTextCellParserIsaSupported(TextCellParserIsa t_isa) noexcept {
+  switch (t_isa) {
+#ifdef TEXT_CELL_PARSER_X86
+    case TextCellParserIsa::Avx2:
+      return __builtin_cpu_supports("avx2");
+    case TextCellParserIsa::Sse42:
+      return __builtin_cpu_supports("sse4.2");
+#endif
+    case TextCellParserIsa::Scalar:
+      return true;
+    default:
+      return false;
+  }
+}
+
+TextCellParserIsa getTextCellParserIsa() noexcept {
+  static const TextCellParserIsa isa = [] {
+    if (isTextCellParserIsaSupported(TextCellParserIsa::Avx2)) {
+      return TextCellParserIsa::Avx2;
+    }
+    if (isTextCellParserIsaSupported(TextCellParserIsa::Sse42)) {
+      return TextCellParserIsa::Sse42;
+    }
+    return TextCellParserIsa::Scalar;
+  }();
+  return isa;
+}
+
+const char* textCellParserIsaName(TextCellParserIsa t_isa) noexcept {
+  switch (t_isa) {
+    case TextCellParserIsa::Avx2:
+      return "avx2";
+    case TextCellParserIsa::Sse42:
+      return "sse4.2";
+    default:
+      return "scalar";
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef TEXT_CELL_PARSER_HPP
+#define TEXT_CELL_PARSER_HPP
+
+#include <cstddef>
+
+/// Перечисление реализаций разбора ячеек текстовой ленты: скалярная и
+/// векторные на наборах инструкций SSE4.2 и AVX2.
+enum class TextCellParserIsa { Scalar, Sse42, Avx2 };
+
+/// Результат разбора блока символов текстовой ленты.
+struct TextCellsParseResult final {
+  /// Количество считанных значений.
+  size_t num_values = 0;
+  /// Количество обработанных символов блока. Если считано запрошенное
+  /// количество значений, то это смещение пробельного символа, следующего за
+  /// последним значением. Иначе, если блок оканчивается незавершённым
+  /// значением, - смещение начала этого значения, а в остальных случаях -
+  /// размер блока.
+  size_t num_chars = 0;
+};
+
+/// Разбирает ячейки текстовой ленты из блока символов и записывает их
+/// значения в переданный буфер. Аргументы: указатель на начало блока, размер
+/// блока, буфер значений, максимальное количество значений, признак
+/// последнего блока ленты и необязательный буфер для смещений начала
+/// значений относительно начала блока.
+///
+/// Блок разбирается по 64 символа: векторная реализация (см.
+/// getTextCellParserIsa()) одновременно классифицирует символы как цифры,
+/// знаки минус и пробельные символы, после чего границы значений находятся по
+/// битовым маскам, а значения до 8 цифр преобразуются в число без цикла по
+/// цифрам. Знак минус допустим только перед цифрами значения.
+///
+/// Незавершённое значение в конце блока, который не является последним, не
+/// считывается (см. TextCellsParseResult::num_chars). При обнаружении
+/// недопустимого символа или значения, выходящего за границы типа 'int',
+/// выбрасывает BadTapeException.
+TextCellsParseResult parseTextCells(const char*, size_t, int*, size_t, bool,
+                                    size_t* t_cell_offsets = nullptr);
+
+/// То же, что parseTextCells(...), но с явно выбранной реализацией. Если
+/// реализация не поддерживается процессором, выбрасывает
+/// std::invalid_argument.
+TextCellsParseResult parseTextCells(TextCellParserIsa, const char*, size_t, int*, size_t, bool,
+                                    size_t* t_cell_offsets = nullptr);
+
+/// Показывает, поддерживает ли процессор переданную реализацию.
+bool isTextCellParserIsaSupported(TextCellParserIsa) noexcept;
+
+/// Возвращает наиболее быструю реализацию, поддерживаемую процессором. Она
+/// определяется один раз при первом обращении.
+TextCellParserIsa getTextCellParserIsa() noexcept;
+
+/// Возвращает имя реализации.
+const char* textCellParserIsaName(TextCellParserIsa) noexcept;
+
+#endif  // TEXT_CELL_PARSER_HPP
@@ -0,0 +1,17 @@
+#include "VirtualClock.hpp"
+
+VirtualClock::VirtualClock() noexcept : m_elapsed_ms(0) {}
+
+void VirtualClock::advance(long long t_delay_ms) noexcept {
+  if (t_delay_ms > 0) {
+    m_elapsed_ms.fetch_add(static_cast<uint64_t>(t_delay_ms), std::memory_order_relaxed);
+  }
+}
+
+uint64_t VirtualClock::getElapsedMs() const noexcept {
+  return m_elapsed_ms.load(std::memory_order_relaxed);
+}
+
+void VirtualClock::reset() noexcept {
+  m_elapsed_ms.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,40 @@
+#ifndef VIRTUAL_CLOCK_HPP
+#define VIRTUAL_CLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Класс VirtualClock
+ *
+ * Виртуальные часы, в которых накапливаются задержки операций ленточных
+ * устройств вместо реального ожидания. Позволяет оценивать стратегии
+ * сортировки при реалистичных задержках приводов со скоростью процессора.
+ *
+ * Задержки всех устройств, которые разделяют одни часы, суммируются, поэтому
+ * время на часах - суммарное время работы устройств, а не время выполнения
+ * сортировки: перекрытие операций разных устройств (например, при
+ * SortWorkersCount больше 1) не учитывается.
+ *
+ * Методы класса потокобезопасны.
+ */
+class VirtualClock final {
+ public:
+  VirtualClock() noexcept;
+
+  /// Продвигает часы на переданное количество миллисекунд. Неположительные
+  /// значения игнорируются.
+  void advance(long long) noexcept;
+
+  /// Возвращает время на часах в миллисекундах.
+  uint64_t getElapsedMs() const noexcept;
+
+  /// Сбрасывает время на часах.
+  void reset() noexcept;
+
+ private:
+  /// Время на часах в миллисекундах.
+  std::atomic<uint64_t> m_elapsed_ms;
+};
+
+#endif  // VIRTUAL_CLOCK_HPP
@@ -0,0 +1,456 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../ITapeDev.hpp"
+#include "../RunSort.hpp"
+#include "../TapeDev.hpp"
+#include "../TapeDevConfig.hpp"
+#include "../TapeDevFactory.hpp"
+#include "../TapeSorter.hpp"
+#include "../TextCellParser.hpp"
+
+namespace {
+
+/// Реализация устройства, на которой выполняются операции с лентой.
+enum class BenchBackend : int64_t { Stream, Mmap, Binary };
+
+/// Распределение значений на входной ленте.
+enum class BenchDistribution : int64_t { Random, Sorted, Reverse, FewUnique };
+
+/// Начальное значение генератора псевдослучайных чисел. Фиксировано, чтобы
+/// ленты с одинаковыми параметрами совпадали между запусками.
+constexpr uint32_t kBenchSeed = 20240501;
+
+/// Количество ячеек лент, на которых измеряются отдельные операции.
+constexpr int64_t kDevOpsTapeSize = 10000;
+
+/// Количество значений в тексте, на котором измеряется разбор ячеек.
+constexpr size_t kParseTextCellsSize = 1000000;
+
+/// Задержки привода (чтение, запись, сдвиг, перемотка), мс, которые
+/// накапливаются в виртуальных часах при сортировке.
+constexpr int kSortReadDelay = 1;
+constexpr int kSortWriteDelay = 1;
+constexpr int kSortShiftDelay = 10;
+constexpr int kSortRewindDelay = 1000;
+
+const char* runSortKernelName(RunSortKernel t_kernel) {
+  switch (t_kernel) {
+    case RunSortKernel::Comparison:
+      return "comparison";
+    case RunSortKernel::Radix:
+      return "radix";
+    default:
+      return "auto";
+  }
+}
+
+const char* backendName(BenchBackend t_backend) {
+  switch (t_backend) {
+    case BenchBackend::Stream:
+      return "stream";
+    case BenchBackend::Mmap:
+      return "mmap";
+    default:
+      return "binary";
+  }
+}
+
+const char* distributionName(BenchDistribution t_distribution) {
+  switch (t_distribution) {
+    case BenchDistribution::Random:
+      return "random";
+    case BenchDistribution::Sorted:
+      return "sorted";
+    case BenchDistribution::Reverse:
+      return "reverse";
+    default:
+      return "few_unique";
+  }
+}
+
+/// Каталог с данными бенчмарков. Имеет ту же структуру, что и ProgramData:
+/// временные ленты сортировщика создаются в var/tmp.
+const std::filesystem::path& benchDataDir() {
+  static const std::filesystem::path data_dir = [] {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "tapedatainterface_bench";
+    std::filesystem::create_directories(dir / "var" / "tmp");
+    return dir;
+  }();
+  return data_dir;
+}
+
+/// Конфигурация устройства без задержек, чтобы измерялась только
+/// реализация операций.
+TapeDevConfig benchConfig(size_t t_mem_buf_size, BenchBackend t_backend) {
+  TapeDevConfig config(benchDataDir() / "device_config.txt", t_mem_buf_size, 0, 0, 0, 0);
+  config.text_tape_backend =
+      t_backend == BenchBackend::Mmap ? TextTapeBackend::Mmap : TextTapeBackend::Stream;
+  return config;
+}
+
+/// Генерирует значения ленты. Для ленты из одинаковых по длине значений
+/// (t_fixed_width) значения лежат в диапазоне [100000, 999999], что позволяет
+/// перезаписывать ячейки текстовой ленты на месте.
+std::vector<int> generateValues(size_t t_num_values, BenchDistribution t_distribution,
+                                bool t_fixed_width) {
+  std::mt19937 gen(kBenchSeed);
+  const int min_value = t_fixed_width ? 100000 : 0;
+  const int max_value = t_fixed_width ? 999999 : 1000000000;
+  std::uniform_int_distribution<int> values(min_value, max_value);
+  std::uniform_int_distribution<int> few_values(min_value, min_value + 15);
+
+  std::vector<int> res(t_num_values);
+  for (int& value : res) {
+    value = t_distribution == BenchDistribution::FewUnique ? few_values(gen) : values(gen);
+  }
+
+  if (t_distribution == BenchDistribution::Sorted) {
+    std::sort(res.begin(), res.end());
+  } else if (t_distribution == BenchDistribution::Reverse) {
+    std::sort(res.rbegin(), res.rend());
+  }
+
+  return res;
+}
+
+/// Возвращает путь к ленте с переданными параметрами. Лента создаётся при
+/// первом обращении и переиспользуется всеми бенчмарками процесса.
+std::filesystem::path benchTape(size_t t_num_values, BenchDistribution t_distribution,
+                                TapeFileFormat t_format, bool t_fixed_width) {
+  static std::map<std::string, std::filesystem::path> tapes;
+
+  const std::string name = std::string("bench_") + distributionName(t_distribution) + "_" +
+                           std::to_string(t_num_values) + (t_fixed_width ? "_fixed" : "") +
+                           (t_format == TapeFileFormat::Binary ? kBinaryTapeFileExtension
+                                                                 : std::string(".txt"));
+
+  auto it = tapes.find(name);
+  if (it != tapes.end()) {
+    return it->second;
+  }
+
+  const std::filesystem::path path = benchDataDir() / name;
+  const std::vector<int> values = generateValues(t_num_values, t_distribution, t_fixed_width);
+  std::unique_ptr<ITapeDev> tape_dev =
+      makeTapeDev(path, benchConfig(1, BenchBackend::Stream), TapeDevOperationMode::Write);
+  tape_dev->writeBlock(values.data(), values.size());
+  tape_dev.reset();
+
+  tapes.emplace(name, path);
+  return path;
+}
+
+std::filesystem::path devOpsTape(BenchBackend t_backend) {
+  return benchTape(kDevOpsTapeSize, BenchDistribution::Random,
+                   t_backend == BenchBackend::Binary ? TapeFileFormat::Binary
+                                                     : TapeFileFormat::Text,
+                   true);
+}
+
+std::unique_ptr<ITapeDev> openDevOpsTape(BenchBackend t_backend, TapeDevOperationMode t_mode) {
+  return makeTapeDev(devOpsTape(t_backend), benchConfig(1, t_backend), t_mode);
+}
+
+void moveToEndOfTape(ITapeDev& t_tape_dev, int64_t t_num_cells) {
+  for (int64_t i = 1; i < t_num_cells; ++i) {
+    t_tape_dev.shiftRight();
+  }
+}
+
+// Операции устройства. Каждая итерация - проход по всей ленте, поэтому
+// результат приводится к количеству ячеек в секунду.
+
+void BM_TapeDevRead(benchmark::State& state) {
+  const auto backend = static_cast<BenchBackend>(state.range(0));
+  std::unique_ptr<ITapeDev> tape_dev = openDevOpsTape(backend, TapeDevOperationMode::Read);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kDevOpsTapeSize; ++i) {
+      benchmark::DoNotOptimize(tape_dev->read());
+      if (i + 1 < kDevOpsTapeSize) {
+        tape_dev->shiftRight();
+      }
+    }
+    state.PauseTiming();
+    tape_dev->rewind();
+    state.ResumeTiming();
+  }
+
+  state.SetLabel(backendName(backend));
+  state.SetItemsProcessed(state.iterations() * kDevOpsTapeSize);
+}
+
+void BM_TapeDevWrite(benchmark::State& state) {
+  const auto backend = static_cast<BenchBackend>(state.range(0));
+  std::unique_ptr<ITapeDev> tape_dev = openDevOpsTape(backend, TapeDevOperationMode::ReadWrite);
+  std::mt19937 gen(kBenchSeed);
+  std::uniform_int_distribution<int> values(100000, 999999);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kDevOpsTapeSize; ++i) {
+      tape_dev->write(values(gen));
+      if (i + 1 < kDevOpsTapeSize) {
+        tape_dev->shiftRight();
+      }
+    }
+    state.PauseTiming();
+    tape_dev->rewind();
+    state.ResumeTiming();
+  }
+
+  state.SetLabel(backendName(backend));
+  state.SetItemsProcessed(state.iterations() * kDevOpsTapeSize);
+}
+
+void BM_TapeDevShiftRight(benchmark::State& state) {
+  const auto backend = static_cast<BenchBackend>(state.range(0));
+  std::unique_ptr<ITapeDev> tape_dev = openDevOpsTape(backend, TapeDevOperationMode::Read);
+
+  for (auto _ : state) {
+    moveToEndOfTape(*tape_dev, kDevOpsTapeSize);
+    state.PauseTiming();
+    tape_dev->rewind();
+    state.ResumeTiming();
+  }
+
+  state.SetLabel(backendName(backend));
+  state.SetItemsProcessed(state.iterations() * (kDevOpsTapeSize - 1));
+}
+
+void BM_TapeDevShiftLeft(benchmark::State& state) {
+  const auto backend = static_cast<BenchBackend>(state.range(0));
+  std::unique_ptr<ITapeDev> tape_dev = openDevOpsTape(backend, TapeDevOperationMode::Read);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    tape_dev->rewind();
+    moveToEndOfTape(*tape_dev, kDevOpsTapeSize);
+    state.ResumeTiming();
+    for (int64_t i = 1; i < kDevOpsTapeSize; ++i) {
+      tape_dev->shiftLeft();
+    }
+  }
+
+  state.SetLabel(backendName(backend));
+  state.SetItemsProcessed(state.iterations() * (kDevOpsTapeSize - 1));
+}
+
+void BM_TapeDevRewind(benchmark::State& state) {
+  const auto backend = static_cast<BenchBackend>(state.range(0));
+  std::unique_ptr<ITapeDev> tape_dev = openDevOpsTape(backend, TapeDevOperationMode::Read);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    moveToEndOfTape(*tape_dev, kDevOpsTapeSize);
+    state.ResumeTiming();
+    tape_dev->rewind();
+  }
+
+  state.SetLabel(backendName(backend));
+}
+
+// Разбор ячеек текстовой ленты в памяти. Аргумент - реализация разбора.
+
+void BM_ParseTextCells(benchmark::State& state) {
+  const auto isa = static_cast<TextCellParserIsa>(state.range(0));
+  if (!isTextCellParserIsaSupported(isa)) {
+    state.SkipWithError("Реализация не поддерживается процессором.");
+    return;
+  }
+
+  const std::vector<int> values =
+      generateValues(kParseTextCellsSize, BenchDistribution::Random, false);
+  std::string text;
+  for (const int value : values) {
+    text += std::to_string(value);
+    text += ' ';
+  }
+  std::vector<int> parsed(values.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        parseTextCells(isa, text.data(), text.size(), parsed.data(), parsed.size(), true));
+  }
+
+  state.SetLabel(textCellParserIsaName(isa));
+  state.SetItemsProcessed(state.iterations() * values.size());
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// Сортировка отрезка в памяти. Аргументы: размер отрезка, алгоритм и
+// распределение значений.
+
+void BM_RunSort(benchmark::State& state) {
+  const auto num_values = static_cast<size_t>(state.range(0));
+  const auto kernel = static_cast<RunSortKernel>(state.range(1));
+  const auto distribution = static_cast<BenchDistribution>(state.range(2));
+
+  const std::vector<int> values = generateValues(num_values, distribution, false);
+  std::vector<int> run(num_values);
+  std::pmr::vector<int> scratch;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(values.begin(), values.end(), run.begin());
+    state.ResumeTiming();
+    sortRun(run.data(), run.size(), kernel, scratch);
+    benchmark::DoNotOptimize(run.data());
+  }
+
+  state.SetLabel(std::string(runSortKernelName(kernel)) + "/" + distributionName(distribution));
+  state.SetItemsProcessed(state.iterations() * num_values);
+}
+
+// Сортировка отрезка записей с полезной нагрузкой по ключу. Аргументы: размер
+// отрезка и алгоритм. Ключи - случайные 64-битные значения.
+
+void BM_RunSortRecords(benchmark::State& state) {
+  const auto num_values = static_cast<size_t>(state.range(0));
+  const auto kernel = static_cast<RunSortKernel>(state.range(1));
+
+  std::mt19937_64 gen(kBenchSeed);
+  std::vector<TapeRecord> records(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    records[i] = TapeRecord{static_cast<int64_t>(gen()), i};
+  }
+  std::vector<TapeRecord> run(num_values);
+  RunSortScratch<TapeRecord> scratch;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::copy(records.begin(), records.end(), run.begin());
+    state.ResumeTiming();
+    sortRun(run.data(), run.size(), kernel, scratch);
+    benchmark::DoNotOptimize(run.data());
+  }
+
+  state.SetLabel(runSortKernelName(kernel));
+  state.SetItemsProcessed(state.iterations() * num_values);
+}
+
+// Сортировка. Аргументы: количество значений на входной ленте, размер буфера
+// памяти устройства и распределение значений.
+
+void BM_TapeSorterSort(benchmark::State& state) {
+  const auto num_values = static_cast<size_t>(state.range(0));
+  const auto mem_buf_size = static_cast<size_t>(state.range(1));
+  const auto distribution = static_cast<BenchDistribution>(state.range(2));
+
+  const std::filesystem::path input_path =
+      benchTape(num_values, distribution, TapeFileFormat::Text, false);
+  const std::filesystem::path output_path = benchDataDir() / "bench_sorted.txt";
+
+  // Задержки привода накапливаются в виртуальных часах, поэтому время
+  // бенчмарка - время работы процессора, а эмулируемое время работы
+  // устройств выводится отдельным счётчиком.
+  TapeDevConfig config = benchConfig(mem_buf_size, BenchBackend::Mmap);
+  config.read_delay = kSortReadDelay;
+  config.write_delay = kSortWriteDelay;
+  config.shift_delay = kSortShiftDelay;
+  config.rewind_delay = kSortRewindDelay;
+  config.virtual_clock = std::make_shared<VirtualClock>();
+
+  uint64_t emulated_time_ms = 0;
+  for (auto _ : state) {
+    TapeDev tape_dev(input_path, config, TapeDevOperationMode::Read);
+    TapeSorter sorter(tape_dev, input_path, output_path, benchDataDir());
+    sorter.sort();
+    emulated_time_ms = sorter.getEmulatedTimeMs();
+  }
+
+  state.SetLabel(distributionName(distribution));
+  state.SetItemsProcessed(state.iterations() * num_values);
+  state.counters["emulated_s"] = static_cast<double>(emulated_time_ms) / 1000.0;
+}
+
+void allBackendsArgs(benchmark::internal::Benchmark* b) {
+  b->ArgName("backend");
+  b->Arg(static_cast<int64_t>(BenchBackend::Stream));
+  b->Arg(static_cast<int64_t>(BenchBackend::Mmap));
+  b->Arg(static_cast<int64_t>(BenchBackend::Binary));
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/// Лента в режиме TapeDevOperationMode::ReadWrite не отображается в память,
+/// поэтому запись измеряется только для потоковой и бинарной реализаций.
+void writableBackendsArgs(benchmark::internal::Benchmark* b) {
+  b->ArgName("backend");
+  b->Arg(static_cast<int64_t>(BenchBackend::Stream));
+  b->Arg(static_cast<int64_t>(BenchBackend::Binary));
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void parserIsaArgs(benchmark::internal::Benchmark* b) {
+  b->ArgName("isa");
+  b->Arg(static_cast<int64_t>(TextCellParserIsa::Scalar));
+  b->Arg(static_cast<int64_t>(TextCellParserIsa::Sse42));
+  b->Arg(static_cast<int64_t>(TextCellParserIsa::Avx2));
+  b->Unit(benchmark::kMillisecond);
+}
+
+/// Перебирает размеры отрезка от 16 до 1e6, оба алгоритма сортировки
+/// отрезков и распределения значений.
+void runSortArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"values", "kernel", "dist"});
+  for (int64_t num_values = 16; num_values <= 1000000; num_values *= 4) {
+    for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Radix}) {
+      for (int64_t dist = 0; dist <= static_cast<int64_t>(BenchDistribution::FewUnique); ++dist) {
+        b->Args({num_values, static_cast<int64_t>(kernel), dist});
+      }
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/// Перебирает размеры отрезка записей от 1024 до 1e6 и оба алгоритма
+/// сортировки отрезков.
+void runSortRecordsArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"values", "kernel"});
+  for (int64_t num_values = 1024; num_values <= 1000000; num_values *= 8) {
+    for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Radix}) {
+      b->Args({num_values, static_cast<int64_t>(kernel)});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/// Перебирает размеры входной ленты от 1e3 до 1e7 и размеры буфера памяти,
+/// пропуская сочетания, при которых вся лента помещается в память или
+/// количество временных лент превышает 1000.
+void sortArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"values", "mem", "dist"});
+  for (int64_t num_values = 1000; num_values <= 10000000; num_values *= 10) {
+    for (int64_t mem_buf_size = 100; mem_buf_size <= 100000; mem_buf_size *= 10) {
+      if (mem_buf_size >= num_values || num_values / mem_buf_size > 1000) {
+        continue;
+      }
+      for (int64_t dist = 0; dist <= static_cast<int64_t>(BenchDistribution::FewUnique); ++dist) {
+        b->Args({num_values, mem_buf_size, dist});
+      }
+    }
+  }
+  b->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(BM_TapeDevRead)->Apply(allBackendsArgs);
+BENCHMARK(BM_TapeDevWrite)->Apply(writableBackendsArgs);
+BENCHMARK(BM_TapeDevShiftRight)->Apply(allBackendsArgs);
+BENCHMARK(BM_TapeDevShiftLeft)->Apply(allBackendsArgs);
+BENCHMARK(BM_TapeDevRewind)->Apply(allBackendsArgs);
+BENCHMARK(BM_ParseTextCells)->Apply(parserIsaArgs);
+BENCHMARK(BM_RunSort)->Apply(runSortArgs);
+BENCHMARK(BM_RunSortRecords)->Apply(runSortRecordsArgs);
+BENCHMARK(BM_TapeSorterSort)->Apply(sortArgs);
+
+BENCHMARK_MAIN();
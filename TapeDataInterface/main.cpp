@@ -1,11 +1,85 @@
 #include <filesystem>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include "TapeDev.hpp"
 #include "TapeDevConfig.hpp"
+#include "TapeDevFactory.hpp"
+#include "TapeDevPool.hpp"
 #include "TapeSorter.hpp"
 
+namespace {
+
+/// Сортирует входную ленту с ячейками типа T и выводит результаты сортировки.
+/// Если передан флаг продолжения, сортировка продолжается с контрольной точки.
+/// Возвращает код завершения программы.
+template <typename T>
+int sortTape(const TapeDevConfig& t_tape_dev_config,
+             const std::filesystem::path& t_in_tape_file_path,
+             const std::filesystem::path& t_out_tape_file_path,
+             const std::filesystem::path& t_program_data_dir_path, bool t_resume) {
+  BasicTapeDev<T> tape_dev(t_in_tape_file_path, t_tape_dev_config, TapeDevOperationMode::Read);
+
+  BasicTapeDevPool<T> tape_dev_pool(t_tape_dev_config);
+
+  BasicTapeSorter<T> tapeSorter(tape_dev, tape_dev_pool, t_in_tape_file_path,
+                                t_out_tape_file_path, t_program_data_dir_path);
+
+  std::cout << "Выполняется сортировка ленты...";
+
+  bool resumed_flag = false;
+  try {
+    if (t_resume) {
+      resumed_flag = tapeSorter.resume();
+    } else {
+      tapeSorter.sort();
+    }
+  } catch (const std::runtime_error& e) {
+    std::cout << "\n\nОШИБКА: " + std::string(e.what()) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << " Успешно" << std::endl;
+
+  if (t_resume) {
+    std::cout << (resumed_flag ? "Сортировка продолжена с контрольной точки."
+                               : "Контрольная точка не найдена или повреждена, сортировка "
+                                 "выполнена заново.")
+              << std::endl;
+  }
+
+  std::cout << std::endl
+            << "Результаты сортировки записаны в файл '" << t_out_tape_file_path.string() << "'."
+            << std::endl;
+
+  if (t_tape_dev_config.virtual_clock) {
+    std::cout << "Эмулируемое время работы устройств: " << tapeSorter.getEmulatedTimeMs()
+              << " мс." << std::endl;
+  }
+
+  std::cout << "Пиковый объём рабочей памяти сортировщика: " << tapeSorter.getPeakMemoryUsage()
+            << " байт";
+  if (t_tape_dev_config.memory_limit != 0) {
+    std::cout << " из " << t_tape_dev_config.memory_limit * sizeof(T) << " байт (MemoryLimit: "
+              << t_tape_dev_config.memory_limit << ")";
+  }
+  std::cout << "." << std::endl;
+
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
 int main(int argc, char** argv) {
+  // Режим продолжения прерванной сортировки:
+  // ./tapedatainterface --resume ./input/tape ./output/tape
+  const bool resume_flag = argc > 1 && std::string(argv[1]) == "--resume";
+  if (resume_flag) {
+    argc -= 1;
+    argv += 1;
+  }
+
   if (argc < 3) {
     std::cout << "ОШИБКА: недопустимые аргументы командной строки. Программа "
                  "принимает 2 аргумента командной строки, получено: "
@@ -13,6 +87,37 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
+  // Режим преобразования ленты между текстовым и бинарным форматами:
+  // ./tapedatainterface --convert ./input/tape ./output/tape [CellType]
+  // Тип ячеек ленты задаётся так же, как параметр CellType в файле
+  // конфигурации устройства, по умолчанию - int32.
+  if (std::string(argv[1]) == "--convert") {
+    if (argc < 4) {
+      std::cout << "ОШИБКА: для преобразования ленты необходимо указать пути к входному и "
+                   "выходному файлам ленты."
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    try {
+      const TapeCellType cell_type =
+          argc > 4 ? tapeCellTypeFromName(argv[4]) : TapeCellType::Int32;
+      size_t num_values = visitTapeCellType(cell_type, [&](auto t_cell) {
+        return convertTapeFile<decltype(t_cell)>(argv[2], argv[3]);
+      });
+      std::cout << "Лента '" << argv[2] << "' преобразована в '" << argv[3]
+                << "'. Количество ячеек: " << num_values << "." << std::endl;
+    } catch (const std::invalid_argument& e) {
+      std::cout << "ОШИБКА: неизвестный тип ячеек ленты '" << e.what() << "'." << std::endl;
+      return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+      std::cout << "ОШИБКА: не удалось преобразовать ленту. Причина: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   std::cout << "\t\t--- Программа для сортировки данных на ленте ---\n\n\n";
 
   // Проверяем, что программа запущена из директории ./yadro-test-task-tu/build.
@@ -115,24 +220,13 @@ int main(int argc, char** argv) {
 
   std::cout << tape_dev_config.to_string() << std::endl << std::endl;
 
-  TapeDev tape_dev(in_tape_file_path, tape_dev_config, TapeDevOperationMode::ReadWrite);
-
-  TapeSorter tapeSorter(tape_dev, in_tape_file_path, out_tape_file_path, program_data_dir_path);
-
-  std::cout << "Выполняется сортировка ленты...";
-
-  try {
-    tapeSorter.sort();
-  } catch (const std::runtime_error& e) {
-    std::cout << "\n\nОШИБКА: " + std::string(e.what()) << std::endl;
-    return EXIT_FAILURE;
+  const int exit_code = visitTapeCellType(tape_dev_config.cell_type, [&](auto t_cell) {
+    return sortTape<decltype(t_cell)>(tape_dev_config, in_tape_file_path, out_tape_file_path,
+                                      program_data_dir_path, resume_flag);
+  });
+  if (exit_code != EXIT_SUCCESS) {
+    return exit_code;
   }
 
-  std::cout << " Успешно" << std::endl;
-
-  std::cout << std::endl
-            << "Результаты сортировки записаны в файл '" << out_tape_file_path.string() << "'."
-            << std::endl;
-
   std::cout << "Завершение работы программы..." << std::endl;
 }
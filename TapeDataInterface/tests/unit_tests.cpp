@@ -1,13 +1,30 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "../BinaryTapeDev.hpp"
+#include "../MappedTapeDev.hpp"
+#include "../RunSort.hpp"
+#include "../SortCheckpoint.hpp"
+#include "../TapeCellIndex.hpp"
 #include "../TapeDev.hpp"
 #include "../TapeDevConfig.hpp"
 #include "../TapeDevExceptions.hpp"
+#include "../TapeDevFactory.hpp"
+#include "../TapeDevPool.hpp"
+#include "../TapeDevStats.hpp"
 #include "../TapeSorter.hpp"
+#include "../TextCellParser.hpp"
 
 class TapeDataInterfaceTest : public ::testing::Test {
  protected:
@@ -44,6 +61,39 @@ class TapeDataInterfaceTest : public ::testing::Test {
     std::filesystem::remove(output_dir / "sort_medium_test_tape.txt");
     std::filesystem::remove(output_dir / "sort_hard_test_tape.txt");
     std::filesystem::remove(output_dir / "sort_empty_tape_test.txt");
+    std::filesystem::remove(output_dir / "padded_test_tape.txt");
+    std::filesystem::remove(output_dir / "write_block_test_tape.txt");
+    std::filesystem::remove(output_dir / "simple_tape.bin");
+    std::filesystem::remove(output_dir / "simple_tape_from_bin.txt");
+    std::filesystem::remove(output_dir / "sort_hard_binary_temp_tapes_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_medium_mmap_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_replacement_selection_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_long_sorted_replacement_selection_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_polyphase_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_polyphase_binary_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_merge_fan_in_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_parallel_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_pipelined_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_radix_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_memory_limit_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_stats_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_stats_test.json");
+    std::filesystem::remove(output_dir / "sort_hard_virtual_clock_test_tape.txt");
+    std::filesystem::remove(output_dir / "cell_index_test_tape.txt");
+    std::filesystem::remove(output_dir / "cell_index_test_tape.txt.idx");
+    std::filesystem::remove(output_dir / "sort_signed_test_tape.txt");
+    std::filesystem::remove(output_dir / "wide_tape.bin");
+    std::filesystem::remove(output_dir / "sort_wide_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_record_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_signed_descending_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_long_sorted_natural_test_tape.txt");
+    std::filesystem::remove(output_dir / "natural_runs_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_natural_runs_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_natural_test_tape.txt");
+    std::filesystem::remove(output_dir / "resume_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_hard_repeated_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_resume_test_tape.txt");
+    std::filesystem::remove(output_dir / "sort_resume_test_tape.bin");
   }
 
   static TapeDev* tape_dev;
@@ -122,6 +172,7 @@ TEST_F(TapeDataInterfaceTest, TapeDevReplaceTapeBadTapeTest) {
 TEST_F(TapeDataInterfaceTest, TapeDevWriteModeWriteValueOnBlankTapeTest) {
   tape_dev->replaceTape(output_dir / "write_blank_test_tape.txt", TapeDevOperationMode::Write);
   tape_dev->write(42);
+  tape_dev->flush();
   std::string file_content = getFileContentAsStr(output_dir / "write_blank_test_tape.txt");
   EXPECT_EQ(file_content, "42");
 }
@@ -129,6 +180,7 @@ TEST_F(TapeDataInterfaceTest, TapeDevWriteModeWriteValueOnBlankTapeTest) {
 TEST_F(TapeDataInterfaceTest, TapeDevAppendModeWriteValueTest) {
   tape_dev->replaceTape(output_dir / "write_blank_test_tape.txt", TapeDevOperationMode::Append);
   tape_dev->write(100);
+  tape_dev->flush();
   std::string file_content = getFileContentAsStr(output_dir / "write_blank_test_tape.txt");
   EXPECT_EQ(file_content, "42 100");
 }
@@ -159,6 +211,36 @@ TEST_F(TapeDataInterfaceTest, TapeDevReadWriteModeWriteValueShiftRightWriteValue
   EXPECT_EQ(file_content, "55 55");
 }
 
+TEST_F(TapeDataInterfaceTest, TapeDevPaddedLayoutReadWriteModeRewriteValueInPlaceTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.text_cell_width = 4;
+  TapeDev padded_tape_dev(output_dir / "padded_test_tape.txt", config,
+                          TapeDevOperationMode::Write);
+  padded_tape_dev.write(1);
+  padded_tape_dev.write(22);
+  padded_tape_dev.write(333);
+  padded_tape_dev.flush();
+  EXPECT_EQ(getFileContentAsStr(output_dir / "padded_test_tape.txt"), "   1   22  333");
+
+  padded_tape_dev.replaceTape(output_dir / "padded_test_tape.txt", TapeDevOperationMode::ReadWrite);
+  padded_tape_dev.shiftRight();
+  padded_tape_dev.write(4444);
+  EXPECT_EQ(padded_tape_dev.read(), 4444);
+  padded_tape_dev.shiftLeft();
+  padded_tape_dev.write(5);
+  EXPECT_EQ(padded_tape_dev.read(), 5);
+  padded_tape_dev.shiftRight();
+  padded_tape_dev.shiftRight();
+  EXPECT_EQ(padded_tape_dev.read(), 333);
+  EXPECT_EQ(getFileContentAsStr(output_dir / "padded_test_tape.txt"), "   5 4444  333");
+
+  // Значение не помещается в ячейку: файл ленты перезаписывается.
+  padded_tape_dev.rewind();
+  padded_tape_dev.write(123456);
+  EXPECT_EQ(padded_tape_dev.read(), 123456);
+  EXPECT_EQ(getFileContentAsStr(output_dir / "padded_test_tape.txt"), "123456 4444  333");
+}
+
 TEST_F(TapeDataInterfaceTest, TapeDevReadWriteModeReadShiftRightReadTest) {
   tape_dev->replaceTape(tapes_dir / "simple_tape.txt", TapeDevOperationMode::ReadWrite);
   std::string res;
@@ -170,6 +252,157 @@ TEST_F(TapeDataInterfaceTest, TapeDevReadWriteModeReadShiftRightReadTest) {
   EXPECT_EQ(res, "2 1");
 }
 
+TEST_F(TapeDataInterfaceTest, TapeDevReadBlockTest) {
+  tape_dev->replaceTape(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read);
+  std::vector<int> block(20);
+  EXPECT_EQ(tape_dev->readBlock(block.data(), 4), 4);
+  EXPECT_EQ(std::vector<int>(block.begin(), block.begin() + 4), std::vector<int>({2, 1, 9, 10}));
+  EXPECT_EQ(tape_dev->getHeadPos(), 4);
+  EXPECT_EQ(tape_dev->read(), 8);
+  EXPECT_EQ(tape_dev->readBlock(block.data(), block.size()), 6);
+  EXPECT_EQ(std::vector<int>(block.begin(), block.begin() + 6),
+            std::vector<int>({8, 7, 6, 5, 4, 3}));
+  EXPECT_EQ(tape_dev->atEndOfTape(), true);
+  EXPECT_EQ(tape_dev->readBlock(block.data(), block.size()), 0);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevWriteBlockTest) {
+  const std::vector<int> block({5, 4, 3});
+  tape_dev->replaceTape(output_dir / "write_block_test_tape.txt", TapeDevOperationMode::Write);
+  tape_dev->writeBlock(block.data(), block.size());
+  tape_dev->write(2);
+  tape_dev->writeBlock(block.data(), 1);
+  // Значения накапливаются в буфере записи до вызова flush().
+  EXPECT_EQ(getFileContentAsStr(output_dir / "write_block_test_tape.txt"), "");
+  tape_dev->flush();
+  EXPECT_EQ(getFileContentAsStr(output_dir / "write_block_test_tape.txt"), "5 4 3 2 5");
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevMemBufViewTest) {
+  tape_dev->setMemBuf({3, 1, 2});
+  const MemBufView view = tape_dev->getMemBufView(3);
+  EXPECT_EQ(view.data, tape_dev->getMemBufData());
+  EXPECT_EQ(view.size, 3);
+  std::sort(view.begin(), view.end());
+  EXPECT_EQ(tape_dev->getMemBufValueAt(0), 1);
+  EXPECT_EQ(tape_dev->getMemBufValueAt(2), 3);
+  EXPECT_EQ(tape_dev->getMemBufView(100).size, tape_dev->getDevMemBufSize());
+}
+
+TEST_F(TapeDataInterfaceTest, TextCellParserIsaTest) {
+  // Значения разной длины и знака с ведущими нулями, разделённые разными
+  // пробельными символами, чтобы значения пересекали границы 64-символьных
+  // блоков.
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> values(0, std::numeric_limits<int>::max());
+  std::uniform_int_distribution<int> num_digits(1, 10);
+  const std::string delims(" \t\n\r\v\f");
+  std::vector<int> expected;
+  std::string text = "  ";
+  for (size_t i = 0; i < 500; ++i) {
+    int value = values(gen);
+    int limit = 1;
+    for (int d = num_digits(gen); d > 1 && limit < 1000000000; --d) {
+      limit *= 10;
+    }
+    value %= limit;
+    const bool negative = i % 3 == 1;
+    expected.push_back(negative ? -value : value);
+    text += std::string(negative ? "-" : "") + (i % 7 == 0 ? "00" : "") + std::to_string(value);
+    text.append(i % 5 + 1, delims.at(i % delims.size()));
+  }
+  text += "2147483647";
+  expected.push_back(std::numeric_limits<int>::max());
+
+  for (const TextCellParserIsa isa :
+       {TextCellParserIsa::Scalar, TextCellParserIsa::Sse42, TextCellParserIsa::Avx2}) {
+    if (!isTextCellParserIsaSupported(isa)) {
+      continue;
+    }
+    SCOPED_TRACE(textCellParserIsaName(isa));
+
+    std::vector<int> parsed(expected.size());
+    std::vector<size_t> offsets(expected.size());
+    TextCellsParseResult res = parseTextCells(isa, text.data(), text.size(), parsed.data(),
+                                              parsed.size(), true, offsets.data());
+    EXPECT_EQ(res.num_values, expected.size());
+    EXPECT_EQ(res.num_chars, text.size());
+    EXPECT_EQ(parsed, expected);
+    EXPECT_EQ(offsets.at(0), 2);
+    EXPECT_EQ(offsets.back(), text.size() - 10);
+
+    // Незавершённое значение в конце не последнего блока не считывается.
+    res = parseTextCells(isa, text.data(), text.size(), parsed.data(), parsed.size(), false);
+    EXPECT_EQ(res.num_values, expected.size() - 1);
+    EXPECT_EQ(res.num_chars, text.size() - 10);
+
+    // При заполнении буфера разбор останавливается на пробельном символе
+    // после последнего значения.
+    res = parseTextCells(isa, text.data(), text.size(), parsed.data(), 1, true);
+    EXPECT_EQ(res.num_values, 1);
+    EXPECT_EQ(res.num_chars, text.find_first_of(delims, 2));
+
+    const std::string bad_char("12 34 5x6 7");
+    EXPECT_THROW(
+        parseTextCells(isa, bad_char.data(), bad_char.size(), parsed.data(), parsed.size(), true),
+        BadTapeException);
+    // Недопустимый символ после последнего запрошенного значения не читается.
+    EXPECT_EQ(parseTextCells(isa, bad_char.data(), bad_char.size(), parsed.data(), 2, true)
+                  .num_values,
+              2);
+    const std::string too_big("1 2147483648 ");
+    EXPECT_THROW(
+        parseTextCells(isa, too_big.data(), too_big.size(), parsed.data(), parsed.size(), true),
+        BadTapeException);
+
+    const std::string int_limits("-2147483648 -0 2147483647");
+    res = parseTextCells(isa, int_limits.data(), int_limits.size(), parsed.data(), parsed.size(),
+                         true);
+    EXPECT_EQ(std::vector<int>(parsed.begin(), parsed.begin() + res.num_values),
+              std::vector<int>({std::numeric_limits<int>::min(), 0,
+                                std::numeric_limits<int>::max()}));
+    // Знак минус допустим только непосредственно перед цифрами значения.
+    for (const std::string bad_value : {"1 -2147483649", "1 5-3", "1 - 3", "1 --3", "1 -"}) {
+      SCOPED_TRACE(bad_value);
+      EXPECT_THROW(parseTextCells(isa, bad_value.data(), bad_value.size(), parsed.data(),
+                                  parsed.size(), true),
+                   BadTapeException);
+    }
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevSignedValuesTest) {
+  const std::vector<int> expected = {2147483647, -5,  0,   -2147483648, 17,          -1, 2147483647,
+                                     -2147483648, 3,  -300, 42,         -2147483647, 0,  -5,
+                                     1000000000,  -1000000000, 7, -7,  2147483646,  -2};
+
+  TapeDev signed_tape_dev(tapes_dir / "signed_tape.txt", tape_dev->getDevConfig(),
+                          TapeDevOperationMode::Read);
+  EXPECT_EQ(signed_tape_dev.read(), std::numeric_limits<int>::max());
+  signed_tape_dev.shiftRight();
+  signed_tape_dev.shiftRight();
+  signed_tape_dev.shiftRight();
+  EXPECT_EQ(signed_tape_dev.read(), std::numeric_limits<int>::min());
+  signed_tape_dev.shiftLeft();
+  EXPECT_EQ(signed_tape_dev.read(), 0);
+  signed_tape_dev.shiftLeft();
+  EXPECT_EQ(signed_tape_dev.read(), -5);
+  signed_tape_dev.rewind();
+  std::vector<int> block(expected.size() + 1);
+  EXPECT_EQ(signed_tape_dev.readBlock(block.data(), block.size()), expected.size());
+  EXPECT_EQ(std::vector<int>(block.begin(), block.begin() + expected.size()), expected);
+
+  MappedTapeDev mapped_tape_dev(tapes_dir / "signed_tape.txt", tape_dev->getDevConfig(),
+                                TapeDevOperationMode::Read);
+  for (size_t i = 0; i < 3; ++i) {
+    mapped_tape_dev.shiftRight();
+  }
+  EXPECT_EQ(mapped_tape_dev.read(), std::numeric_limits<int>::min());
+  mapped_tape_dev.rewind();
+  EXPECT_EQ(mapped_tape_dev.readBlock(block.data(), block.size()), expected.size());
+  EXPECT_EQ(std::vector<int>(block.begin(), block.begin() + expected.size()), expected);
+}
+
 TEST_F(TapeDataInterfaceTest, TapeDevReadModeReadValueOnBlankTapeTest) {
   tape_dev->replaceTape(tapes_dir / "empty_tape.txt", TapeDevOperationMode::Read);
   EXPECT_THROW(tape_dev->read(), BadTapeException);
@@ -185,6 +418,930 @@ TEST_F(TapeDataInterfaceTest, TapeDevWriteModeInvalidReadOperationTest) {
   EXPECT_THROW(tape_dev->read(), InvalidOperationException);
 }
 
+TEST_F(TapeDataInterfaceTest, TapeDevVirtualClockAccountsEveryOperationTest) {
+  TapeDevConfig config("", 5, 7, 11, 13, 17);
+  config.virtual_clock = std::make_shared<VirtualClock>();
+  TapeDev virtual_tape_dev(tapes_dir / "simple_tape.txt", config, TapeDevOperationMode::Read);
+  virtual_tape_dev.read();
+  EXPECT_EQ(config.virtual_clock->getElapsedMs(), 7);
+  virtual_tape_dev.shiftRight();
+  virtual_tape_dev.shiftLeft();
+  EXPECT_EQ(config.virtual_clock->getElapsedMs(), 7 + 2 * 13);
+  virtual_tape_dev.rewind();
+  EXPECT_EQ(config.virtual_clock->getElapsedMs(), 7 + 2 * 13 + 17);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevCellIndexSeekToCellTest) {
+  const std::filesystem::path tape_path = output_dir / "cell_index_test_tape.txt";
+  std::filesystem::copy_file(tapes_dir / "hard_tape.txt", tape_path,
+                             std::filesystem::copy_options::overwrite_existing);
+  std::vector<int> values;
+  std::ifstream tape_file(tape_path);
+  for (int value; tape_file >> value;) {
+    values.push_back(value);
+  }
+
+  TapeDevConfig config("", 5, 0, 0, 3, 0);
+  config.cell_index_stride = 16;
+  config.virtual_clock = std::make_shared<VirtualClock>();
+  {
+    TapeDev indexing_tape_dev(tape_path, config, TapeDevOperationMode::Read);
+    indexing_tape_dev.seekToCell(40);
+    EXPECT_EQ(indexing_tape_dev.getHeadPos(), 40);
+    EXPECT_EQ(indexing_tape_dev.read(), values.at(40));
+    indexing_tape_dev.seekToCell(17);
+    EXPECT_EQ(indexing_tape_dev.read(), values.at(17));
+    // Задержка сдвига эмулируется для всего пройденного расстояния.
+    EXPECT_EQ(config.virtual_clock->getElapsedMs(), 3 * (40 + 23));
+
+    // Проход до конца ленты завершает индекс и сохраняет его в файл.
+    std::vector<int> block(values.size());
+    indexing_tape_dev.readBlock(block.data(), block.size());
+    EXPECT_TRUE(indexing_tape_dev.atEndOfTape());
+  }
+  EXPECT_TRUE(std::filesystem::exists(TapeCellIndex::indexFilePath(tape_path)));
+
+  TapeDev tape_dev_with_index(tape_path, config, TapeDevOperationMode::Read);
+  for (const size_t cell : {values.size() - 1, size_t(5), size_t(33), size_t(0)}) {
+    tape_dev_with_index.seekToCell(cell);
+    EXPECT_EQ(tape_dev_with_index.getHeadPos(), cell);
+    EXPECT_EQ(tape_dev_with_index.read(), values.at(cell));
+  }
+  tape_dev_with_index.seekToCell(values.size() + 10);
+  EXPECT_TRUE(tape_dev_with_index.atEndOfTape());
+
+  // Устройство, изменяющее ленту, удаляет устаревший файл индекса.
+  TapeDev write_tape_dev(tape_path, config, TapeDevOperationMode::Append);
+  EXPECT_FALSE(std::filesystem::exists(TapeCellIndex::indexFilePath(tape_path)));
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevPoolIndependentHeadsTest) {
+  TapeDevPool pool(tape_dev->getDevConfig());
+  ITapeDev& first_dev = pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read);
+  ITapeDev& second_dev = pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read);
+  second_dev.shiftRight();
+  second_dev.shiftRight();
+  EXPECT_EQ(first_dev.read(), 2);
+  EXPECT_EQ(second_dev.read(), 9);
+  EXPECT_EQ(pool.getNumDevsInUse(), 2);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevPoolExhaustedTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.tape_drives_count = 1;
+  TapeDevPool pool(config);
+  ITapeDev& dev = pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read);
+  EXPECT_THROW(pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read),
+               TapeDevPoolExhaustedException);
+  pool.release(dev);
+  EXPECT_NO_THROW(pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read));
+}
+
+TEST_F(TapeDataInterfaceTest, BinaryTapeDevConvertRoundTripTest) {
+  EXPECT_EQ(convertTapeFile(tapes_dir / "simple_tape.txt", output_dir / "simple_tape.bin"), 10);
+  {
+    BinaryTapeDev binary_tape_dev(output_dir / "simple_tape.bin", tape_dev->getDevConfig(),
+                                  TapeDevOperationMode::Read);
+    EXPECT_EQ(binary_tape_dev.getCellCount(), 10);
+    EXPECT_EQ(binary_tape_dev.read(), 2);
+    binary_tape_dev.shiftRight();
+    binary_tape_dev.shiftRight();
+    EXPECT_EQ(binary_tape_dev.read(), 9);
+  }
+  EXPECT_EQ(convertTapeFile(output_dir / "simple_tape.bin", output_dir / "simple_tape_from_bin.txt"),
+            10);
+  EXPECT_EQ(getFileContentAsStr(output_dir / "simple_tape_from_bin.txt"), "2 1 9 10 8 7 6 5 4 3");
+}
+
+TEST_F(TapeDataInterfaceTest, BinaryTapeDevReadWriteModeRewriteValueInPlaceTest) {
+  convertTapeFile(tapes_dir / "simple_tape.txt", output_dir / "simple_tape.bin");
+  const auto file_size = std::filesystem::file_size(output_dir / "simple_tape.bin");
+  {
+    BinaryTapeDev binary_tape_dev(output_dir / "simple_tape.bin", tape_dev->getDevConfig(),
+                                  TapeDevOperationMode::ReadWrite);
+    binary_tape_dev.shiftRight();
+    binary_tape_dev.shiftRight();
+    binary_tape_dev.write(-7);
+    binary_tape_dev.shiftLeft();
+    EXPECT_EQ(binary_tape_dev.read(), 1);
+    binary_tape_dev.shiftRight();
+    EXPECT_EQ(binary_tape_dev.read(), -7);
+    EXPECT_EQ(binary_tape_dev.getCellCount(), 10);
+  }
+  EXPECT_EQ(std::filesystem::file_size(output_dir / "simple_tape.bin"), file_size);
+}
+
+TEST_F(TapeDataInterfaceTest, BinaryTapeDevReadWriteBlockTest) {
+  convertTapeFile(tapes_dir / "simple_tape.txt", output_dir / "simple_tape.bin");
+  BinaryTapeDev binary_tape_dev(output_dir / "simple_tape.bin", tape_dev->getDevConfig(),
+                                TapeDevOperationMode::ReadWrite);
+  const std::vector<int> new_values({-1, -2, -3});
+  binary_tape_dev.shiftRight();
+  binary_tape_dev.writeBlock(new_values.data(), new_values.size());
+  EXPECT_EQ(binary_tape_dev.getHeadPos(), 4);
+  binary_tape_dev.rewind();
+  std::vector<int> block(20);
+  EXPECT_EQ(binary_tape_dev.readBlock(block.data(), block.size()), 10);
+  block.resize(10);
+  EXPECT_EQ(block, std::vector<int>({2, -1, -2, -3, 8, 7, 6, 5, 4, 3}));
+  EXPECT_EQ(binary_tape_dev.atEndOfTape(), true);
+}
+
+TEST_F(TapeDataInterfaceTest, BinaryTapeDevBadTapeTest) {
+  EXPECT_THROW(BinaryTapeDev(tapes_dir / "simple_tape.txt", tape_dev->getDevConfig(),
+                             TapeDevOperationMode::Read),
+               BadTapeException);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterSortWithBinaryTempTapesTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.temp_tape_format = TapeFileFormat::Binary;
+  TapeDev binary_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(binary_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_binary_temp_tapes_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_binary_temp_tapes_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, MappedTapeDevShiftAndReadTest) {
+  MappedTapeDev mapped_tape_dev(tapes_dir / "simple_tape.txt", tape_dev->getDevConfig(),
+                                TapeDevOperationMode::Read);
+  EXPECT_EQ(mapped_tape_dev.read(), 2);
+  mapped_tape_dev.shiftRight();
+  mapped_tape_dev.shiftRight();
+  mapped_tape_dev.shiftRight();
+  EXPECT_EQ(mapped_tape_dev.read(), 10);
+  mapped_tape_dev.shiftLeft();
+  EXPECT_EQ(mapped_tape_dev.read(), 9);
+  for (size_t i = 0; i < 10; ++i) {
+    mapped_tape_dev.shiftRight();
+  }
+  EXPECT_EQ(mapped_tape_dev.atEndOfTape(), true);
+  EXPECT_THROW(mapped_tape_dev.read(), EndOfTapeException);
+  mapped_tape_dev.rewind();
+  EXPECT_EQ(mapped_tape_dev.atStartOfTape(), true);
+  EXPECT_EQ(mapped_tape_dev.read(), 2);
+}
+
+TEST_F(TapeDataInterfaceTest, MappedTapeDevReadBlockTest) {
+  MappedTapeDev mapped_tape_dev(tapes_dir / "simple_tape.txt", tape_dev->getDevConfig(),
+                                TapeDevOperationMode::Read);
+  std::vector<int> block(20);
+  mapped_tape_dev.shiftRight();
+  EXPECT_EQ(mapped_tape_dev.readBlock(block.data(), 3), 3);
+  EXPECT_EQ(std::vector<int>(block.begin(), block.begin() + 3), std::vector<int>({1, 9, 10}));
+  EXPECT_EQ(mapped_tape_dev.read(), 8);
+  EXPECT_EQ(mapped_tape_dev.readBlock(block.data(), block.size()), 6);
+  EXPECT_EQ(mapped_tape_dev.atEndOfTape(), true);
+}
+
+TEST_F(TapeDataInterfaceTest, MappedTapeDevInvalidModeTest) {
+  EXPECT_THROW(MappedTapeDev(tapes_dir / "simple_tape.txt", tape_dev->getDevConfig(),
+                             TapeDevOperationMode::ReadWrite),
+               InvalidOperationException);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterSortWithMappedTapeDevsTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.text_tape_backend = TextTapeBackend::Mmap;
+  TapeDev mem_tape_dev(tapes_dir / "medium_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "medium_tape.txt",
+                    output_dir / "sort_medium_mmap_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  std::string file_content = getFileContentAsStr(output_dir / "sort_medium_mmap_test_tape.txt");
+  EXPECT_EQ(file_content,
+            "2 2 2 3 5 6 8 9 9 10 11 12 14 14 14 17 18 18 18 21 21 21 22 22 22 24 24 25 25 27 27 "
+            "29 31 33 34 34 36 36 38 39 39 42 43 45 46 46 47 47 49 50");
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterReplacementSelectionSortHardTapeTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::ReplacementSelection;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_replacement_selection_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // Разбиение на части размером с буфер памяти дало бы 20 отрезков.
+  EXPECT_LT(sorter.getNumRuns(), 20);
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_replacement_selection_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterReplacementSelectionSortedTapeSingleRunTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::ReplacementSelection;
+  TapeDev mem_tape_dev(tapes_dir / "long_sorted_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "long_sorted_tape.txt",
+                    output_dir / "sort_long_sorted_replacement_selection_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  EXPECT_EQ(sorter.getNumRuns(), 1);
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_long_sorted_replacement_selection_test_tape.txt");
+  EXPECT_EQ(file_content,
+            "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 "
+            "32 33 34 35 36 37 38 39 40 41 42 43 44 45 46 47 48 49 50 51 52 53 54 55 56 57 58 59 "
+            "60 61 62 63 64 65 66 67 68 69 70 71 72 73 74 75 76 77 78 79 80 81 82 83 84 85 86 87 "
+            "88 89 90 91 92 93 94 95 96 97 98 99 100");
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterPolyphaseSortHardTapeTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.polyphase_tapes_count = 3;
+  // Многофазному слиянию достаточно по одному приводу на каждую ленту.
+  config.tape_drives_count = 3;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_polyphase_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  EXPECT_EQ(sorter.getNumRuns(), 20);
+  std::string file_content = getFileContentAsStr(output_dir / "sort_hard_polyphase_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterBoundedMergeFanInTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.merge_fan_in = 3;
+  // Слиянию с ограниченным количеством входов достаточно приводов для
+  // merge_fan_in временных лент и выходной ленты.
+  config.tape_drives_count = 4;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_merge_fan_in_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  EXPECT_EQ(sorter.getNumRuns(), 20);
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_merge_fan_in_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+
+  // Конфигурация, созданная без файла конфигурации, проверяется сортировщиком.
+  config.merge_fan_in = 1;
+  TapeDev invalid_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter invalid_sorter(invalid_tape_dev, tapes_dir / "hard_tape.txt",
+                            output_dir / "sort_hard_merge_fan_in_test_tape.txt",
+                            "../../TapeDataInterface/tests/tests-data/");
+  EXPECT_THROW(invalid_sorter.sort(), std::runtime_error);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterPolyphaseReplacementSelectionBinaryTempTapesTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.polyphase_tapes_count = 5;
+  config.run_generation = RunGenerationStrategy::ReplacementSelection;
+  config.temp_tape_format = TapeFileFormat::Binary;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_polyphase_binary_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_polyphase_binary_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterParallelForwardPassTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.sort_workers_count = 4;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_parallel_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  std::string file_content = getFileContentAsStr(output_dir / "sort_hard_parallel_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterPipelinedChunkRunsTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::PipelinedChunk;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_pipelined_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // Буфер памяти из 5 ячеек делится на половины из 2 и 3 ячеек.
+  EXPECT_EQ(sorter.getNumRuns(), 40);
+  std::string file_content = getFileContentAsStr(output_dir / "sort_hard_pipelined_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterNaturalRunsSortedTapeTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  TapeDev mem_tape_dev(tapes_dir / "long_sorted_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "long_sorted_tape.txt",
+                    output_dir / "sort_long_sorted_natural_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // Отсортированная лента переносится на выходную ленту единственным
+  // отрезком, без сортировки в памяти.
+  EXPECT_EQ(sorter.getNumRuns(), 1);
+  EXPECT_EQ(getFileContentAsStr(output_dir / "sort_long_sorted_natural_test_tape.txt"),
+            getFileContentAsStr(tapes_dir / "long_sorted_tape.txt"));
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterNaturalRunsTest) {
+  // Два возрастающих участка, граница между которыми приходится на середину
+  // блока из 5 ячеек, и убывающий участок из 4 блоков.
+  std::string input;
+  std::string expected;
+  for (int i = 10; i <= 52; ++i) {
+    input += std::to_string(i) + " ";
+  }
+  for (int i = 0; i < 42; ++i) {
+    input += std::to_string(i) + " ";
+  }
+  for (int i = 119; i >= 100; --i) {
+    input += std::to_string(i) + (i == 100 ? "" : " ");
+  }
+  {
+    std::ofstream input_file(output_dir / "natural_runs_test_tape.txt");
+    input_file << input;
+  }
+
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  TapeDev mem_tape_dev(output_dir / "natural_runs_test_tape.txt", config,
+                       TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, output_dir / "natural_runs_test_tape.txt",
+                    output_dir / "sort_natural_runs_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // По отрезку на каждый возрастающий участок и на каждый обращённый блок
+  // убывающего участка, кроме первого, который продолжает второй участок.
+  EXPECT_EQ(sorter.getNumRuns(), 2 + 20 / 5 - 1);
+
+  std::vector<int> values;
+  for (int i = 10; i <= 52; ++i) {
+    values.push_back(i);
+  }
+  for (int i = 0; i < 42; ++i) {
+    values.push_back(i);
+  }
+  for (int i = 100; i < 120; ++i) {
+    values.push_back(i);
+  }
+  std::sort(values.begin(), values.end());
+  for (size_t i = 0; i < values.size(); ++i) {
+    expected += std::to_string(values[i]) + (i + 1 == values.size() ? "" : " ");
+  }
+  EXPECT_EQ(getFileContentAsStr(output_dir / "sort_natural_runs_test_tape.txt"), expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterNaturalRunsHardTapeTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_natural_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // На случайных данных отрезков не больше, чем при разбиении на части.
+  EXPECT_LE(sorter.getNumRuns(), 20);
+  std::string file_content = getFileContentAsStr(output_dir / "sort_hard_natural_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterRepeatedSortTest) {
+  const std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+
+  // Повторная сортировка тем же сортировщиком начинается с начала входной
+  // ленты и не использует временные ленты предыдущей сортировки.
+  for (const size_t polyphase_tapes_count : {0, 3}) {
+    SCOPED_TRACE(polyphase_tapes_count);
+    TapeDevConfig config = tape_dev->getDevConfig();
+    config.polyphase_tapes_count = polyphase_tapes_count;
+    TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+    TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                      output_dir / "sort_hard_repeated_test_tape.txt",
+                      "../../TapeDataInterface/tests/tests-data/");
+    for (int i = 0; i < 2; ++i) {
+      sorter.sort();
+      EXPECT_EQ(sorter.getNumRuns(), 20);
+      EXPECT_EQ(getFileContentAsStr(output_dir / "sort_hard_repeated_test_tape.txt"), expected);
+    }
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterOutputFlushErrorTest) {
+  // Все значения помещаются в буфер памяти, поэтому выходная лента
+  // записывается одним блоком и сбрасывается только перед освобождением
+  // устройства. Ошибка записи на /dev/full должна дойти до вызывающего кода.
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.mem_buf_size = 20;
+  TapeDev mem_tape_dev(tapes_dir / "simple_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "simple_tape.txt", "/dev/full",
+                    "../../TapeDataInterface/tests/tests-data/");
+  EXPECT_THROW(sorter.sort(), std::runtime_error);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterResumeTest) {
+  // Два естественных отрезка: 11..20 и 1..10.
+  {
+    std::ofstream input_file(output_dir / "resume_test_tape.txt");
+    input_file << "11 12 13 14 15 16 17 18 19 20 1 2 3 4 5 6 7 8 9 10";
+  }
+  const std::filesystem::path data_dir("../../TapeDataInterface/tests/tests-data/");
+  const std::filesystem::path manifest_path = SortCheckpoint::manifestPath(data_dir);
+
+  // Двух приводов достаточно для формирования отрезков, но не для слияния,
+  // поэтому сортировка прерывается после записи контрольной точки.
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  config.checkpoint_interval = 4;
+  config.tape_drives_count = 2;
+  TapeDev mem_tape_dev(output_dir / "resume_test_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter interrupted_sorter(mem_tape_dev, output_dir / "resume_test_tape.txt",
+                                output_dir / "sort_resume_test_tape.txt", data_dir);
+  EXPECT_THROW(interrupted_sorter.sort(), std::runtime_error);
+
+  SortCheckpoint checkpoint;
+  ASSERT_TRUE(checkpoint.load(manifest_path));
+  EXPECT_TRUE(checkpoint.runs_complete);
+  EXPECT_EQ(checkpoint.input_cells, 20);
+  EXPECT_EQ(std::vector<size_t>(checkpoint.run_sizes.begin(), checkpoint.run_sizes.end()),
+            std::vector<size_t>({10, 10}));
+
+  // Имитируем прерывание слияния: на выходную ленту записаны значения 1..10
+  // из второго отрезка и одно значение после контрольной точки.
+  {
+    std::ofstream output_file(output_dir / "sort_resume_test_tape.txt");
+    output_file << "1 2 3 4 5 6 7 8 9 10 11";
+  }
+  checkpoint.merge_output_cells = 10;
+  checkpoint.merge_output_bytes = std::string("1 2 3 4 5 6 7 8 9 10").size();
+  checkpoint.merge_consumed.assign({0, 10});
+  checkpoint.save(manifest_path);
+
+  config.tape_drives_count = 0;
+  TapeDev resumed_tape_dev(output_dir / "resume_test_tape.txt", config,
+                           TapeDevOperationMode::Read);
+  TapeSorter resumed_sorter(resumed_tape_dev, output_dir / "resume_test_tape.txt",
+                            output_dir / "sort_resume_test_tape.txt", data_dir);
+  EXPECT_TRUE(resumed_sorter.resume());
+  EXPECT_EQ(resumed_sorter.getNumRuns(), 2);
+  EXPECT_EQ(getFileContentAsStr(output_dir / "sort_resume_test_tape.txt"),
+            "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20");
+  EXPECT_FALSE(std::filesystem::exists(manifest_path));
+
+  // Без контрольной точки сортировка выполняется заново.
+  TapeSorter fresh_sorter(resumed_tape_dev, output_dir / "resume_test_tape.txt",
+                          output_dir / "sort_resume_test_tape.txt", data_dir);
+  EXPECT_FALSE(fresh_sorter.resume());
+  EXPECT_EQ(getFileContentAsStr(output_dir / "sort_resume_test_tape.txt"),
+            "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20");
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterCorruptedCheckpointTest) {
+  {
+    std::ofstream input_file(output_dir / "resume_test_tape.txt");
+    input_file << "11 12 13 14 15 16 17 18 19 20 1 2 3 4 5 6 7 8 9 10";
+  }
+  const std::filesystem::path data_dir("../../TapeDataInterface/tests/tests-data/");
+  const std::filesystem::path manifest_path = SortCheckpoint::manifestPath(data_dir);
+
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  config.checkpoint_interval = 4;
+  TapeDev mem_tape_dev(output_dir / "resume_test_tape.txt", config, TapeDevOperationMode::Read);
+
+  // Манифест, который не удаётся разобрать, и манифест, в котором с
+  // временной ленты записано больше значений, чем содержит её отрезок.
+  const std::string corrupted_manifests[] = {
+      "\x01\x02 мусор\nRunSizes: 10 x\n",
+      "RunsComplete: 1\nRunSizes: 10 10\nRunsSorted: 1 1\nMergeConsumed: 0 11\n"};
+  for (const std::string& manifest : corrupted_manifests) {
+    {
+      std::ofstream manifest_file(manifest_path);
+      manifest_file << manifest;
+    }
+    TapeSorter sorter(mem_tape_dev, output_dir / "resume_test_tape.txt",
+                      output_dir / "sort_resume_test_tape.txt", data_dir);
+    EXPECT_FALSE(sorter.resume());
+    EXPECT_EQ(getFileContentAsStr(output_dir / "sort_resume_test_tape.txt"),
+              "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20");
+    EXPECT_FALSE(std::filesystem::exists(manifest_path));
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterBinaryOutputResumeTest) {
+  {
+    std::ofstream input_file(output_dir / "resume_test_tape.txt");
+    input_file << "11 12 13 14 15 16 17 18 19 20 1 2 3 4 5 6 7 8 9 10";
+  }
+  const std::filesystem::path data_dir("../../TapeDataInterface/tests/tests-data/");
+  const std::filesystem::path manifest_path = SortCheckpoint::manifestPath(data_dir);
+  const std::filesystem::path output_path = output_dir / "sort_resume_test_tape.bin";
+
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_generation = RunGenerationStrategy::Natural;
+  config.checkpoint_interval = 4;
+  config.tape_drives_count = 2;
+  TapeDev mem_tape_dev(output_dir / "resume_test_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter interrupted_sorter(mem_tape_dev, output_dir / "resume_test_tape.txt", output_path,
+                                data_dir);
+  EXPECT_THROW(interrupted_sorter.sort(), std::runtime_error);
+
+  SortCheckpoint checkpoint;
+  ASSERT_TRUE(checkpoint.load(manifest_path));
+
+  // Имитируем аварийное прерывание слияния: на бинарную выходную ленту
+  // записаны значения 1..10 и одно значение после контрольной точки, а
+  // количество ячеек в заголовке осталось нулевым, как после открытия ленты.
+  {
+    BinaryTapeDev output_tape_dev(output_path, config, TapeDevOperationMode::Write);
+    for (int value = 1; value <= 11; ++value) {
+      output_tape_dev.write(value);
+    }
+  }
+  {
+    std::fstream output_file(output_path, std::ios::in | std::ios::out | std::ios::binary);
+    output_file.seekp(sizeof(BinaryTapeDev::kMagic));
+    const char zero_cell_count[sizeof(std::uint64_t)] = {};
+    output_file.write(zero_cell_count, sizeof(zero_cell_count));
+  }
+  checkpoint.merge_output_cells = 10;
+  checkpoint.merge_output_bytes = BinaryTapeDev::kHeaderSize + 10 * BinaryTapeDev::kCellSize;
+  checkpoint.merge_consumed.assign({0, 10});
+  checkpoint.save(manifest_path);
+
+  config.tape_drives_count = 0;
+  TapeDev resumed_tape_dev(output_dir / "resume_test_tape.txt", config,
+                           TapeDevOperationMode::Read);
+  TapeSorter resumed_sorter(resumed_tape_dev, output_dir / "resume_test_tape.txt", output_path,
+                            data_dir);
+  EXPECT_TRUE(resumed_sorter.resume());
+
+  BinaryTapeDev output_tape_dev(output_path, config, TapeDevOperationMode::Read);
+  std::vector<int> values(21);
+  values.resize(output_tape_dev.readBlock(values.data(), values.size()));
+  std::vector<int> expected(20);
+  std::iota(expected.begin(), expected.end(), 1);
+  EXPECT_EQ(values, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, RunSortKernelsTest) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> values(std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::max());
+  std::vector<int> expected(1000);
+  for (int& value : expected) {
+    value = values(gen);
+  }
+  expected.push_back(std::numeric_limits<int>::min());
+  expected.push_back(std::numeric_limits<int>::max());
+  expected.push_back(0);
+  expected.push_back(-1);
+
+  std::vector<int> radix = expected;
+  std::vector<int> comparison = expected;
+  std::pmr::vector<int> scratch;
+  std::sort(expected.begin(), expected.end());
+  sortRun(radix.data(), radix.size(), RunSortKernel::Radix, scratch);
+  sortRun(comparison.data(), comparison.size(), RunSortKernel::Comparison, scratch);
+  EXPECT_EQ(radix, expected);
+  EXPECT_EQ(comparison, expected);
+  EXPECT_EQ(scratch.size(), expected.size());
+
+  // Проходы по совпадающим у всех значений байтам пропускаются.
+  std::vector<int> same_high_bytes({0x1203, 0x1201, 0x1202});
+  sortRun(same_high_bytes.data(), same_high_bytes.size(), RunSortKernel::Radix, scratch);
+  EXPECT_EQ(same_high_bytes, std::vector<int>({0x1201, 0x1202, 0x1203}));
+}
+
+TEST_F(TapeDataInterfaceTest, RunSortRecordsByTagsTest) {
+  std::mt19937_64 gen(42);
+  std::vector<TapeRecord> wide_keys(2000);
+  std::vector<TapeRecord> narrow_keys(2000);
+  for (size_t i = 0; i < wide_keys.size(); ++i) {
+    // Ключи с большим разбросом отличаются в младших битах, не вошедших в
+    // префикс тега, а ключи с малым разбросом часто повторяются.
+    wide_keys[i] = TapeRecord{static_cast<std::int64_t>(gen()) >> (i % 3 == 0 ? 40 : 0), i};
+    narrow_keys[i] = TapeRecord{static_cast<std::int64_t>(gen() % 64) - 32, i};
+  }
+  wide_keys.push_back(TapeRecord{std::numeric_limits<std::int64_t>::min(), 1});
+  wide_keys.push_back(TapeRecord{std::numeric_limits<std::int64_t>::max(), 2});
+
+  RunSortScratch<TapeRecord> scratch;
+  for (std::vector<TapeRecord> records : {wide_keys, narrow_keys}) {
+    std::vector<TapeRecord> expected = records;
+    std::stable_sort(expected.begin(), expected.end());
+    sortRun(records.data(), records.size(), RunSortKernel::Radix, scratch);
+    EXPECT_EQ(records, expected);
+  }
+  // Буфер тегов вмещает теги отрезка и копию отрезка.
+  EXPECT_EQ(scratch.size(), 3 * wide_keys.size());
+
+  // Сортировка сравнениями, в том числе выбранная RunSortKernel::Auto для
+  // короткого отрезка, также сохраняет порядок записей с равными ключами.
+  const std::vector<TapeRecord> short_run(narrow_keys.begin(), narrow_keys.begin() + 500);
+  for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Auto}) {
+    for (std::vector<TapeRecord> records : {narrow_keys, short_run}) {
+      std::vector<TapeRecord> expected = records;
+      std::stable_sort(expected.begin(), expected.end());
+      sortRun(records.data(), records.size(), kernel, scratch);
+      EXPECT_EQ(records, expected);
+    }
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterRadixRunSortKernelTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.run_sort_kernel = RunSortKernel::Radix;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_radix_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  std::string file_content = getFileContentAsStr(output_dir / "sort_hard_radix_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterSortSignedTapeTest) {
+  const std::string expected(
+      "-2147483648 -2147483648 -2147483647 -1000000000 -300 -7 -5 -5 -2 -1 0 0 3 7 17 42 "
+      "1000000000 2147483646 2147483647 2147483647");
+
+  for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Radix}) {
+    SCOPED_TRACE(static_cast<int>(kernel));
+    TapeDevConfig config = tape_dev->getDevConfig();
+    config.run_sort_kernel = kernel;
+    TapeDev mem_tape_dev(tapes_dir / "signed_tape.txt", config, TapeDevOperationMode::Read);
+    TapeSorter sorter(mem_tape_dev, tapes_dir / "signed_tape.txt",
+                      output_dir / "sort_signed_test_tape.txt",
+                      "../../TapeDataInterface/tests/tests-data/");
+    sorter.sort();
+    EXPECT_EQ(getFileContentAsStr(output_dir / "sort_signed_test_tape.txt"), expected);
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevWideCellTypesTest) {
+  const TapeDevConfig& config = tape_dev->getDevConfig();
+
+  BasicTapeDev<std::int64_t> int64_tape_dev(tapes_dir / "wide_tape.txt", config,
+                                            TapeDevOperationMode::Read);
+  EXPECT_EQ(int64_tape_dev.read(), std::numeric_limits<std::int64_t>::max());
+  int64_tape_dev.shiftRight();
+  EXPECT_EQ(int64_tape_dev.read(), -1);
+
+  // Значения за границами типа ячеек и знак минус у беззнакового типа
+  // недопустимы.
+  TapeDev int32_tape_dev(tapes_dir / "wide_tape.txt", config, TapeDevOperationMode::Read);
+  EXPECT_THROW(int32_tape_dev.read(), BadTapeException);
+  BasicMappedTapeDev<std::uint64_t> uint64_tape_dev(tapes_dir / "wide_tape.txt", config,
+                                                    TapeDevOperationMode::Read);
+  EXPECT_EQ(uint64_tape_dev.read(), 9223372036854775807u);
+  EXPECT_THROW(
+      {
+        uint64_tape_dev.shiftRight();
+        uint64_tape_dev.read();
+      },
+      BadTapeException);
+
+  // Сигнатура бинарного файла ленты зависит от типа ячеек.
+  EXPECT_EQ(
+      convertTapeFile<std::int64_t>(tapes_dir / "wide_tape.txt", output_dir / "wide_tape.bin"), 20);
+  BasicBinaryTapeDev<std::int64_t> binary_tape_dev(output_dir / "wide_tape.bin", config,
+                                                   TapeDevOperationMode::Read);
+  EXPECT_EQ(binary_tape_dev.getCellCount(), 20);
+  binary_tape_dev.seekToCell(3);
+  EXPECT_EQ(binary_tape_dev.read(), std::numeric_limits<std::int64_t>::min());
+  EXPECT_THROW(BinaryTapeDev(output_dir / "wide_tape.bin", config, TapeDevOperationMode::Read),
+               BadTapeException);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterSortWideTapeTest) {
+  const std::string expected(
+      "-9223372036854775808 -9223372036854775807 -5000000000 -2147483649 -12 -7 -3 -1 0 1 2 3 7 "
+      "12 2147483648 4294967296 5000000000 100000000000 9223372036854775806 9223372036854775807");
+
+  for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Radix}) {
+    SCOPED_TRACE(static_cast<int>(kernel));
+    TapeDevConfig config = tape_dev->getDevConfig();
+    config.run_sort_kernel = kernel;
+    config.temp_tape_format = TapeFileFormat::Binary;
+    BasicTapeDev<std::int64_t> mem_tape_dev(tapes_dir / "wide_tape.txt", config,
+                                            TapeDevOperationMode::Read);
+    BasicTapeSorter<std::int64_t> sorter(mem_tape_dev, tapes_dir / "wide_tape.txt",
+                                         output_dir / "sort_wide_test_tape.txt",
+                                         "../../TapeDataInterface/tests/tests-data/");
+    sorter.sort();
+    EXPECT_EQ(getFileContentAsStr(output_dir / "sort_wide_test_tape.txt"), expected);
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterSortRecordTapeTest) {
+  const auto by_key_and_payload = [](const TapeRecord& t_lhs, const TapeRecord& t_rhs) {
+    return t_lhs.key != t_rhs.key ? t_lhs.key < t_rhs.key : t_lhs.payload < t_rhs.payload;
+  };
+
+  std::vector<TapeRecord> input(100);
+  {
+    BasicTapeDev<TapeRecord> input_tape_dev(tapes_dir / "record_tape.txt",
+                                            tape_dev->getDevConfig(), TapeDevOperationMode::Read);
+    input.resize(input_tape_dev.readBlock(input.data(), input.size()));
+  }
+  ASSERT_EQ(input.size(), 24);
+  std::sort(input.begin(), input.end(), by_key_and_payload);
+
+  for (const RunSortKernel kernel : {RunSortKernel::Comparison, RunSortKernel::Radix}) {
+    SCOPED_TRACE(static_cast<int>(kernel));
+    TapeDevConfig config = tape_dev->getDevConfig();
+    config.run_sort_kernel = kernel;
+    config.run_generation = RunGenerationStrategy::ReplacementSelection;
+    BasicTapeDev<TapeRecord> mem_tape_dev(tapes_dir / "record_tape.txt", config,
+                                          TapeDevOperationMode::Read);
+    BasicTapeSorter<TapeRecord> sorter(mem_tape_dev, tapes_dir / "record_tape.txt",
+                                       output_dir / "sort_record_test_tape.txt",
+                                       "../../TapeDataInterface/tests/tests-data/");
+    sorter.sort();
+
+    BasicTapeDev<TapeRecord> output_tape_dev(output_dir / "sort_record_test_tape.txt", config,
+                                             TapeDevOperationMode::Read);
+    std::vector<TapeRecord> output(100);
+    output.resize(output_tape_dev.readBlock(output.data(), output.size()));
+
+    // Записи упорядочены по ключу, а полезная нагрузка осталась при своём
+    // ключе.
+    EXPECT_TRUE(std::is_sorted(output.begin(), output.end()));
+    std::sort(output.begin(), output.end(), by_key_and_payload);
+    EXPECT_EQ(output, input);
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterDescendingOrderTest) {
+  const std::string expected(
+      "2147483647 2147483647 2147483646 1000000000 42 17 7 3 0 0 -1 -2 -5 -5 -7 -300 -1000000000 "
+      "-2147483647 -2147483648 -2147483648");
+
+  for (const RunGenerationStrategy run_generation :
+       {RunGenerationStrategy::Chunk, RunGenerationStrategy::ReplacementSelection}) {
+    SCOPED_TRACE(static_cast<int>(run_generation));
+    TapeDevConfig config = tape_dev->getDevConfig();
+    config.run_sort_kernel = RunSortKernel::Radix;
+    config.run_generation = run_generation;
+    TapeDev mem_tape_dev(tapes_dir / "signed_tape.txt", config, TapeDevOperationMode::Read);
+    BasicTapeSorter<int, std::greater<int>> sorter(
+        mem_tape_dev, tapes_dir / "signed_tape.txt",
+        output_dir / "sort_signed_descending_test_tape.txt",
+        "../../TapeDataInterface/tests/tests-data/");
+    sorter.sort();
+    EXPECT_EQ(getFileContentAsStr(output_dir / "sort_signed_descending_test_tape.txt"), expected);
+  }
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterMemoryLimitTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.memory_limit = 1000;
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_memory_limit_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  // В рабочей памяти учитываются буфер памяти устройства и контейнеры
+  // сортировщика.
+  EXPECT_GT(sorter.getPeakMemoryUsage(), config.mem_buf_size * sizeof(int));
+  EXPECT_LE(sorter.getPeakMemoryUsage(), config.memory_limit * sizeof(int));
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_memory_limit_test_tape.txt");
+  EXPECT_EQ(file_content.substr(0, 20), "1 3 5 5 6 7 9 10 10 ");
+
+  // Ограничения, равного размеру буфера памяти, недостаточно для
+  // контейнеров сортировщика.
+  config.memory_limit = config.mem_buf_size;
+  TapeDev tight_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter tight_sorter(tight_tape_dev, tapes_dir / "hard_tape.txt",
+                          output_dir / "sort_hard_memory_limit_test_tape.txt",
+                          "../../TapeDataInterface/tests/tests-data/");
+  EXPECT_THROW(tight_sorter.sort(), std::runtime_error);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterTapeDevStatsTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.write_delay = 1;
+  config.stats_file = output_dir / "sort_hard_stats_test.json";
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeDevPool pool(config);
+  TapeSorter sorter(mem_tape_dev, pool, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_stats_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+
+  // Каждое из 100 значений записывается при разбиении на временные ленты, на
+  // прямом ходе и при слиянии.
+  const TapeStats total = sorter.getTapeDevStats().getTotalStats();
+  const TapeOperationStats& write_stats = total.at(static_cast<size_t>(TapeDevOperation::Write));
+  EXPECT_EQ(write_stats.cells, 300);
+  EXPECT_EQ(write_stats.emulated_time_ms, 300);
+  EXPECT_EQ(total.at(static_cast<size_t>(TapeDevOperation::Read)).cells, 300);
+
+  const TapeStats output_stats =
+      sorter.getTapeDevStats().getTapeStats(output_dir / "sort_hard_stats_test_tape.txt");
+  EXPECT_EQ(output_stats.at(static_cast<size_t>(TapeDevOperation::Write)).calls, 100);
+  EXPECT_EQ(output_stats.at(static_cast<size_t>(TapeDevOperation::TapeSwap)).calls, 1);
+
+  std::ifstream json_file(output_dir / "sort_hard_stats_test.json");
+  std::string json((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+  EXPECT_NE(json.find("\"total\": {"), std::string::npos);
+  EXPECT_NE(json.find("\"emulated_time_ms\": 300"), std::string::npos);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeDevStatsNoOpShiftsTest) {
+  TapeDevConfig config = tape_dev->getDevConfig();
+  config.shift_delay = 1;
+  config.stats_file = output_dir / "unused_stats.json";
+  TapeDevPool pool(config);
+  IBasicTapeDev<int>& dev = pool.acquire(tapes_dir / "simple_tape.txt", TapeDevOperationMode::Read);
+
+  // Сдвиги в начале и за концом ленты из 10 ячеек головку не перемещают.
+  dev.shiftLeft();
+  for (int i = 0; i < 15; ++i) {
+    dev.shiftRight();
+  }
+
+  const TapeStats stats = pool.getStats().getTapeStats(tapes_dir / "simple_tape.txt");
+  EXPECT_EQ(stats.at(static_cast<size_t>(TapeDevOperation::ShiftLeft)).calls, 0);
+  EXPECT_EQ(stats.at(static_cast<size_t>(TapeDevOperation::ShiftRight)).calls, 10);
+  EXPECT_EQ(stats.at(static_cast<size_t>(TapeDevOperation::ShiftRight)).emulated_time_ms, 10);
+}
+
+TEST_F(TapeDataInterfaceTest, TapeSorterVirtualClockSortTest) {
+  // При реальном ожидании сортировка с такими задержками заняла бы минуты.
+  TapeDevConfig config("", 5, 100, 100, 100, 1000);
+  config.virtual_clock = std::make_shared<VirtualClock>();
+  TapeDev mem_tape_dev(tapes_dir / "hard_tape.txt", config, TapeDevOperationMode::Read);
+  TapeSorter sorter(mem_tape_dev, tapes_dir / "hard_tape.txt",
+                    output_dir / "sort_hard_virtual_clock_test_tape.txt",
+                    "../../TapeDataInterface/tests/tests-data/");
+  sorter.sort();
+  EXPECT_GT(sorter.getEmulatedTimeMs(), 0);
+  EXPECT_EQ(sorter.getEmulatedTimeMs(), config.virtual_clock->getElapsedMs());
+  std::string file_content =
+      getFileContentAsStr(output_dir / "sort_hard_virtual_clock_test_tape.txt");
+  std::string expected(
+      "1 3 5 5 6 7 9 10 10 11 12 13 14 16 16 16 17 17 18 18 19 20 21 22 23 24 24 25 25 26 27 28 29 "
+      "30 31 31 32 32 33 35 35 36 36 38 38 39 39 40 41 45 47 47 48 48 49 54 55 55 56 59 60 61 62 "
+      "62 63 63 65 67 69 70 70 73 74 74 76 76 78 79 79 79 80 80 81 83 84 84 84 85 85 85 87 88 88 "
+      "90 93 94 95 96 99 100");
+  EXPECT_EQ(file_content, expected);
+}
+
 TEST_F(TapeDataInterfaceTest, TapeSorterSortEmptyTapeTest) {
   tape_dev->replaceTape(tapes_dir / "empty_tape.txt", TapeDevOperationMode::Read);
   delete tape_sorter;
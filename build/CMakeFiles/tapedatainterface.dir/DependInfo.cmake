@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/TapeDataInterface/BinaryTapeDev.cpp" "CMakeFiles/tapedatainterface.dir/BinaryTapeDev.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/BinaryTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/InstrumentedTapeDev.cpp" "CMakeFiles/tapedatainterface.dir/InstrumentedTapeDev.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/InstrumentedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MappedTapeDev.cpp" "CMakeFiles/tapedatainterface.dir/MappedTapeDev.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/MappedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MemoryArena.cpp" "CMakeFiles/tapedatainterface.dir/MemoryArena.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/MemoryArena.cpp.o.d"
+  "/root/repo/TapeDataInterface/RunSort.cpp" "CMakeFiles/tapedatainterface.dir/RunSort.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/RunSort.cpp.o.d"
+  "/root/repo/TapeDataInterface/SortCheckpoint.cpp" "CMakeFiles/tapedatainterface.dir/SortCheckpoint.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/SortCheckpoint.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeCellIndex.cpp" "CMakeFiles/tapedatainterface.dir/TapeCellIndex.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeCellIndex.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDev.cpp" "CMakeFiles/tapedatainterface.dir/TapeDev.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevConfig.cpp" "CMakeFiles/tapedatainterface.dir/TapeDevConfig.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeDevConfig.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevFactory.cpp" "CMakeFiles/tapedatainterface.dir/TapeDevFactory.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeDevFactory.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevPool.cpp" "CMakeFiles/tapedatainterface.dir/TapeDevPool.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeDevPool.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevStats.cpp" "CMakeFiles/tapedatainterface.dir/TapeDevStats.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeDevStats.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeSorter.cpp" "CMakeFiles/tapedatainterface.dir/TapeSorter.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TapeSorter.cpp.o.d"
+  "/root/repo/TapeDataInterface/TextCellParser.cpp" "CMakeFiles/tapedatainterface.dir/TextCellParser.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/TextCellParser.cpp.o.d"
+  "/root/repo/TapeDataInterface/VirtualClock.cpp" "CMakeFiles/tapedatainterface.dir/VirtualClock.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/VirtualClock.cpp.o.d"
+  "/root/repo/TapeDataInterface/main.cpp" "CMakeFiles/tapedatainterface.dir/main.cpp.o" "gcc" "CMakeFiles/tapedatainterface.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
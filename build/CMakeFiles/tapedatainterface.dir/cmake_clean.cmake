@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tapedatainterface.dir/BinaryTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/BinaryTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/InstrumentedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/InstrumentedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/MappedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/MappedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/MemoryArena.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/MemoryArena.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/RunSort.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/RunSort.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/SortCheckpoint.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/SortCheckpoint.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeCellIndex.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeCellIndex.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeDevConfig.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeDevConfig.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeDevFactory.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeDevFactory.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeDevPool.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeDevPool.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeDevStats.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeDevStats.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TapeSorter.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TapeSorter.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/TextCellParser.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/TextCellParser.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/VirtualClock.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/VirtualClock.cpp.o.d"
+  "CMakeFiles/tapedatainterface.dir/main.cpp.o"
+  "CMakeFiles/tapedatainterface.dir/main.cpp.o.d"
+  "tapedatainterface"
+  "tapedatainterface.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tapedatainterface.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
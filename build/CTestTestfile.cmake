@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/TapeDataInterface
+# Build directory: /root/repo/build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("_deps/googletest-build")
+subdirs("tests")
+subdirs("benchmarks")
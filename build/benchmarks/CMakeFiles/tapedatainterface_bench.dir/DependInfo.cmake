@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/TapeDataInterface/BinaryTapeDev.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/BinaryTapeDev.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/BinaryTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/InstrumentedTapeDev.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/InstrumentedTapeDev.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/InstrumentedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MappedTapeDev.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/MappedTapeDev.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/MappedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MemoryArena.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/MemoryArena.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/MemoryArena.cpp.o.d"
+  "/root/repo/TapeDataInterface/RunSort.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/RunSort.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/RunSort.cpp.o.d"
+  "/root/repo/TapeDataInterface/SortCheckpoint.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/SortCheckpoint.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/SortCheckpoint.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeCellIndex.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeCellIndex.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeCellIndex.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDev.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDev.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevConfig.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevConfig.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevConfig.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevFactory.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevFactory.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevFactory.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevPool.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevPool.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevPool.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevStats.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevStats.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeDevStats.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeSorter.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeSorter.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TapeSorter.cpp.o.d"
+  "/root/repo/TapeDataInterface/TextCellParser.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TextCellParser.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/TextCellParser.cpp.o.d"
+  "/root/repo/TapeDataInterface/VirtualClock.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/VirtualClock.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/__/VirtualClock.cpp.o.d"
+  "/root/repo/TapeDataInterface/benchmarks/benchmarks.cpp" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/benchmarks.cpp.o" "gcc" "benchmarks/CMakeFiles/tapedatainterface_bench.dir/benchmarks.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tapedatainterface_bench.dir/__/BinaryTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/BinaryTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/InstrumentedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/InstrumentedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/MappedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/MappedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/MemoryArena.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/MemoryArena.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/RunSort.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/RunSort.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/SortCheckpoint.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/SortCheckpoint.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeCellIndex.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeCellIndex.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevConfig.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevConfig.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevFactory.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevFactory.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevPool.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevPool.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevStats.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeDevStats.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeSorter.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TapeSorter.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TextCellParser.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/TextCellParser.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/__/VirtualClock.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/__/VirtualClock.cpp.o.d"
+  "CMakeFiles/tapedatainterface_bench.dir/benchmarks.cpp.o"
+  "CMakeFiles/tapedatainterface_bench.dir/benchmarks.cpp.o.d"
+  "tapedatainterface_bench"
+  "tapedatainterface_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tapedatainterface_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/TapeDataInterface/BinaryTapeDev.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/BinaryTapeDev.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/BinaryTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/InstrumentedTapeDev.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/InstrumentedTapeDev.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/InstrumentedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MappedTapeDev.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/MappedTapeDev.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/MappedTapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/MemoryArena.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/MemoryArena.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/MemoryArena.cpp.o.d"
+  "/root/repo/TapeDataInterface/RunSort.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/RunSort.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/RunSort.cpp.o.d"
+  "/root/repo/TapeDataInterface/SortCheckpoint.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/SortCheckpoint.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/SortCheckpoint.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeCellIndex.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeCellIndex.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeCellIndex.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDev.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDev.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDev.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevConfig.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevConfig.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevConfig.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevFactory.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevFactory.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevFactory.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevPool.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevPool.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevPool.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeDevStats.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevStats.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevStats.cpp.o.d"
+  "/root/repo/TapeDataInterface/TapeSorter.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeSorter.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeSorter.cpp.o.d"
+  "/root/repo/TapeDataInterface/TextCellParser.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TextCellParser.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/TextCellParser.cpp.o.d"
+  "/root/repo/TapeDataInterface/VirtualClock.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/VirtualClock.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/__/VirtualClock.cpp.o.d"
+  "/root/repo/TapeDataInterface/tests/unit_tests.cpp" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/unit_tests.cpp.o" "gcc" "tests/CMakeFiles/tapedatainterface_unit_tests.dir/unit_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
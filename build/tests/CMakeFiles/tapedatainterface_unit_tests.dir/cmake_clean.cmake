@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/BinaryTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/BinaryTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/InstrumentedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/InstrumentedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/MappedTapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/MappedTapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/MemoryArena.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/MemoryArena.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/RunSort.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/RunSort.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/SortCheckpoint.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/SortCheckpoint.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeCellIndex.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeCellIndex.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDev.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDev.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevConfig.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevConfig.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevFactory.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevFactory.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevPool.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevPool.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevStats.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeDevStats.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeSorter.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TapeSorter.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TextCellParser.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/TextCellParser.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/VirtualClock.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/__/VirtualClock.cpp.o.d"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/unit_tests.cpp.o"
+  "CMakeFiles/tapedatainterface_unit_tests.dir/unit_tests.cpp.o.d"
+  "tapedatainterface_unit_tests"
+  "tapedatainterface_unit_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tapedatainterface_unit_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()